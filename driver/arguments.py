@@ -88,6 +88,8 @@ Examples:
 
 COMPONENTS_PLUS_OVERALL = ["translate", "search", "validate", "overall"]
 DEFAULT_SAS_FILE = "output.sas"
+# Magic number of the binary task format of the search component.
+BINARY_TASK_MAGIC = b"\x89FDTASK\n"
 
 
 """
@@ -183,9 +185,11 @@ def _check_mutex_args(parser, args, required=False):
 
 
 def _looks_like_search_input(filename):
-    with open(filename) as input_file:
-        first_line = next(input_file, "").rstrip()
-    return first_line == "begin_version"
+    with open(filename, "rb") as input_file:
+        first_line = input_file.readline()
+    # Translator output or binary task written with --write-binary-task.
+    return (first_line.rstrip() == b"begin_version" or
+            first_line == BINARY_TASK_MAGIC)
 
 
 def _set_components_automatically(parser, args):
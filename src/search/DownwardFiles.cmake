@@ -51,6 +51,7 @@ fast_downward_plugin(
         abstract_task
         axioms
         command_line
+        disk_cache
         estimation_info
         estimator
         beauty_hash_estimator
@@ -60,6 +61,7 @@ fast_downward_plugin(
         evaluation_result
         evaluator
         evaluator_cache
+        expansion_arena
         heuristic
         open_list
         open_list_factory
@@ -74,6 +76,7 @@ fast_downward_plugin(
         plan_manager
         plugin
         pruning_method
+        search_checkpoint
         search_engine
         search_node_info
         search_progress
@@ -118,6 +121,7 @@ fast_downward_plugin(
         utils/hash
         utils/language
         utils/logging
+        utils/mapped_file
         utils/markup
         utils/math
         utils/memory
@@ -127,6 +131,7 @@ fast_downward_plugin(
         utils/system
         utils/system_unix
         utils/system_windows
+        utils/thread_pool
         utils/timer
     CORE_PLUGIN
 )
@@ -241,6 +246,7 @@ fast_downward_plugin(
     NAME SEGMENTED_VECTOR
     HELP "Memory-friendly and vector-like data structure"
     SOURCES
+        algorithms/segment_storage
         algorithms/segmented_vector
     DEPENDENCY_ONLY
 )
@@ -475,7 +481,7 @@ fast_downward_plugin(
    HELP "Beauty edge-cost estimation search algorithm"
    SOURCES
        search_engines/beauty
-   DEPENDS NULL_PRUNING_METHOD ORDERED_SET SUCCESSOR_GENERATOR
+   DEPENDS EXTRA_TASKS NULL_PRUNING_METHOD ORDERED_SET SUCCESSOR_GENERATOR
 )
 
 fast_downward_plugin(
@@ -524,6 +530,7 @@ fast_downward_plugin(
     SOURCES
         heuristics/array_pool
         heuristics/relaxation_heuristic
+    DEPENDS EXTRA_TASKS
     DEPENDENCY_ONLY
 )
 
@@ -587,7 +594,7 @@ fast_downward_plugin(
     HELP "The h^m heuristic"
     SOURCES
         heuristics/hm_heuristic
-    DEPENDS TASK_PROPERTIES
+    DEPENDS FACT_TUPLE_INDEX TASK_PROPERTIES
 )
 
 fast_downward_plugin(
@@ -596,7 +603,7 @@ fast_downward_plugin(
     SOURCES
         heuristics/lm_cut_heuristic
         heuristics/lm_cut_landmarks
-    DEPENDS PRIORITY_QUEUES TASK_PROPERTIES
+    DEPENDS EXTRA_TASKS PRIORITY_QUEUES TASK_PROPERTIES
 )
 
 fast_downward_plugin(
@@ -611,6 +618,7 @@ fast_downward_plugin(
     NAME CORE_TASKS
     HELP "Core task transformations"
     SOURCES
+        tasks/binary_root_task
         tasks/cost_adapted_task
         tasks/delegating_task
         tasks/root_task
@@ -623,6 +631,7 @@ fast_downward_plugin(
     SOURCES
         tasks/domain_abstracted_task
         tasks/domain_abstracted_task_factory
+        tasks/estimated_operator_costs_task
         tasks/modified_goals_task
         tasks/modified_operator_costs_task
     DEPENDS TASK_PROPERTIES
@@ -637,6 +646,14 @@ fast_downward_plugin(
     DEPENDENCY_ONLY
 )
 
+fast_downward_plugin(
+    NAME FACT_TUPLE_INDEX
+    HELP "Perfect hash function for sets of facts"
+    SOURCES
+        task_utils/fact_tuple_index
+    DEPENDENCY_ONLY
+)
+
 fast_downward_plugin(
     NAME SAMPLING
     HELP "Sampling"
@@ -758,7 +775,7 @@ fast_downward_plugin(
         landmarks/landmark_graph
         landmarks/landmark_status_manager
         landmarks/util
-    DEPENDS LP_SOLVER PRIORITY_QUEUES SUCCESSOR_GENERATOR TASK_PROPERTIES
+    DEPENDS FACT_TUPLE_INDEX LP_SOLVER PRIORITY_QUEUES SUCCESSOR_GENERATOR TASK_PROPERTIES
 )
 
 fast_downward_plugin(
@@ -783,6 +800,7 @@ fast_downward_plugin(
         pdbs/incremental_canonical_pdbs
         pdbs/match_tree
         pdbs/max_cliques
+        pdbs/packed_distances
         pdbs/pattern_cliques
         pdbs/pattern_collection_information
         pdbs/pattern_collection_generator_combo
@@ -802,7 +820,7 @@ fast_downward_plugin(
         pdbs/validation
         pdbs/zero_one_pdbs
         pdbs/zero_one_pdbs_heuristic
-    DEPENDS CAUSAL_GRAPH MAX_CLIQUES PRIORITY_QUEUES SAMPLING SUCCESSOR_GENERATOR TASK_PROPERTIES VARIABLE_ORDER_FINDER
+    DEPENDS CAUSAL_GRAPH EXTRA_TASKS MAX_CLIQUES PRIORITY_QUEUES SAMPLING SUCCESSOR_GENERATOR TASK_PROPERTIES VARIABLE_ORDER_FINDER
 )
 
 fast_downward_plugin(
@@ -0,0 +1,234 @@
+#include "segment_storage.h"
+
+#include "../utils/logging.h"
+#include "../utils/system.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace segmented_vector {
+static const size_t SEGMENT_ALIGNMENT = alignof(max_align_t);
+
+/*
+  The installed storage is intentionally never destroyed because segments
+  may still be deallocated during static destruction at program exit.
+*/
+static MappedSegmentStorage *segment_storage = nullptr;
+
+static size_t align_size(size_t bytes) {
+    return (bytes + SEGMENT_ALIGNMENT - 1) / SEGMENT_ALIGNMENT * SEGMENT_ALIGNMENT;
+}
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+static void exit_with_storage_error(const string &message) {
+    cerr << "Segment storage: " << message << ": " << strerror(errno) << endl;
+    utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+}
+
+MappedSegmentStorage::MappedSegmentStorage(
+    const string &directory, int max_resident_mb)
+    : max_resident_chunks(
+          max(static_cast<size_t>(max_resident_mb) * 1024 * 1024 / CHUNK_BYTES,
+              size_t(1))),
+      fd(-1),
+      file_size(0),
+      num_allocated_segments(0),
+      num_reused_segments(0),
+      num_page_outs(0) {
+    string file_template = directory + "/downward-segments-XXXXXX";
+    vector<char> buffer(file_template.begin(), file_template.end());
+    buffer.push_back('\0');
+    fd = mkstemp(buffer.data());
+    if (fd == -1) {
+        exit_with_storage_error("could not create file in " + directory);
+    }
+    file_name = buffer.data();
+    // The file is removed as soon as the planner closes it or terminates.
+    unlink(file_name.c_str());
+}
+
+MappedSegmentStorage::~MappedSegmentStorage() {
+    for (const Chunk &chunk : chunks) {
+        munmap(chunk.data, chunk.size);
+    }
+    close(fd);
+}
+
+int MappedSegmentStorage::add_chunk(size_t min_size) {
+    size_t size = max(CHUNK_BYTES, align_size(min_size));
+    size_t new_file_size = file_size + size;
+    if (ftruncate(fd, new_file_size) == -1) {
+        exit_with_storage_error("could not grow " + file_name);
+    }
+    void *data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                      fd, file_size);
+    if (data == MAP_FAILED) {
+        exit_with_storage_error("could not map " + file_name);
+    }
+    madvise(data, size, MADV_SEQUENTIAL);
+    Chunk chunk;
+    chunk.data = static_cast<char *>(data);
+    chunk.size = size;
+    chunk.used = 0;
+    chunk.resident = false;
+    chunks.push_back(chunk);
+    file_size = new_file_size;
+    return chunks.size() - 1;
+}
+
+void MappedSegmentStorage::mark_used(int chunk_id) {
+    Chunk &chunk = chunks[chunk_id];
+    if (chunk.resident) {
+        if (resident_chunks.back() == chunk_id) {
+            return;
+        }
+        resident_chunks.erase(
+            find(resident_chunks.begin(), resident_chunks.end(), chunk_id));
+    }
+    chunk.resident = true;
+    resident_chunks.push_back(chunk_id);
+    while (resident_chunks.size() > max_resident_chunks) {
+        int lru_chunk_id = resident_chunks.front();
+        resident_chunks.erase(resident_chunks.begin());
+        page_out(lru_chunk_id);
+    }
+}
+
+void MappedSegmentStorage::page_out(int chunk_id) {
+    Chunk &chunk = chunks[chunk_id];
+    assert(chunk.resident);
+    chunk.resident = false;
+    /*
+      Dirty pages of a shared file mapping are written back to the file
+      before they are dropped, so the data is preserved.
+    */
+#ifdef MADV_PAGEOUT
+    madvise(chunk.data, chunk.size, MADV_PAGEOUT);
+#else
+    msync(chunk.data, chunk.size, MS_ASYNC);
+    madvise(chunk.data, chunk.size, MADV_DONTNEED);
+#endif
+    ++num_page_outs;
+}
+
+int MappedSegmentStorage::find_chunk(const void *ptr) const {
+    const char *address = static_cast<const char *>(ptr);
+    for (size_t chunk_id = 0; chunk_id < chunks.size(); ++chunk_id) {
+        const Chunk &chunk = chunks[chunk_id];
+        if (address >= chunk.data && address < chunk.data + chunk.size) {
+            return chunk_id;
+        }
+    }
+    return -1;
+}
+
+void *MappedSegmentStorage::allocate(size_t bytes) {
+    size_t size = align_size(bytes);
+    auto it = free_segments.find(size);
+    if (it != free_segments.end() && !it->second.empty()) {
+        pair<void *, int> segment = it->second.back();
+        it->second.pop_back();
+        mark_used(segment.second);
+        ++num_reused_segments;
+        return segment.first;
+    }
+
+    int chunk_id = -1;
+    if (!chunks.empty()) {
+        const Chunk &last_chunk = chunks.back();
+        if (last_chunk.size - last_chunk.used >= size) {
+            chunk_id = chunks.size() - 1;
+        }
+    }
+    if (chunk_id == -1) {
+        chunk_id = add_chunk(size);
+    }
+    Chunk &chunk = chunks[chunk_id];
+    void *segment = chunk.data + chunk.used;
+    chunk.used += size;
+    mark_used(chunk_id);
+    ++num_allocated_segments;
+    return segment;
+}
+
+bool MappedSegmentStorage::deallocate(void *ptr, size_t bytes) {
+    int chunk_id = find_chunk(ptr);
+    if (chunk_id == -1) {
+        return false;
+    }
+    free_segments[align_size(bytes)].emplace_back(ptr, chunk_id);
+    return true;
+}
+
+void MappedSegmentStorage::print_statistics() const {
+    utils::g_log << "Segment storage file size: " << file_size / 1024
+                 << " KB" << endl;
+    utils::g_log << "Segment storage chunks: " << chunks.size()
+                 << " (" << resident_chunks.size() << " resident)" << endl;
+    utils::g_log << "Segment storage allocated segments: "
+                 << num_allocated_segments << endl;
+    utils::g_log << "Segment storage reused segments: "
+                 << num_reused_segments << endl;
+    utils::g_log << "Segment storage page-outs: " << num_page_outs << endl;
+}
+#else
+MappedSegmentStorage::MappedSegmentStorage(const string &, int)
+    : max_resident_chunks(0),
+      fd(-1),
+      file_size(0),
+      num_allocated_segments(0),
+      num_reused_segments(0),
+      num_page_outs(0) {
+    cerr << "Memory-mapped segment storage is not supported on this "
+         << "operating system." << endl;
+    utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+}
+
+MappedSegmentStorage::~MappedSegmentStorage() {
+}
+
+void *MappedSegmentStorage::allocate(size_t) {
+    ABORT("Memory-mapped segment storage is not supported.");
+}
+
+bool MappedSegmentStorage::deallocate(void *, size_t) {
+    return false;
+}
+
+void MappedSegmentStorage::print_statistics() const {
+}
+#endif
+
+void set_segment_storage(unique_ptr<MappedSegmentStorage> storage) {
+    assert(!segment_storage);
+    segment_storage = storage.release();
+}
+
+MappedSegmentStorage *get_segment_storage() {
+    return segment_storage;
+}
+
+void *allocate_segment(size_t bytes) {
+    if (segment_storage) {
+        return segment_storage->allocate(bytes);
+    }
+    return ::operator new(bytes);
+}
+
+void deallocate_segment(void *ptr, size_t bytes) {
+    if (!segment_storage || !segment_storage->deallocate(ptr, bytes)) {
+        ::operator delete(ptr);
+    }
+}
+}
@@ -0,0 +1,143 @@
+#ifndef ALGORITHMS_SEGMENT_STORAGE_H
+#define ALGORITHMS_SEGMENT_STORAGE_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/*
+  Storage backends for the segments of SegmentedVector and
+  SegmentedArrayVector.
+
+  By default, segments are allocated on the heap. If a
+  MappedSegmentStorage is installed with set_segment_storage(), all
+  segments that are allocated from then on are placed in a file-backed
+  shared memory mapping in a given directory instead. The kernel can then
+  write segments that are not in use back to the file and read them in
+  again on demand, so searches whose state registry and per-state
+  information outgrow the available RAM slow down instead of running out
+  of memory.
+
+  The mapped file is split into chunks of CHUNK_BYTES bytes from which the
+  segments are carved out in order. The storage keeps a list of resident
+  chunks ordered by their last use for allocations. Whenever the resident
+  chunks exceed the configured resident memory, the least recently used
+  chunk is paged out to disk. Accessing data of a paged-out chunk
+  transparently faults it in again. New chunks are advised for sequential
+  access because segments are filled in order.
+
+  Note that mapped memory still counts towards address-space limits
+  (RLIMIT_AS, as set by the driver's --search-memory-limit). The storage
+  helps with limits on resident memory, e.g., cgroup limits of cluster
+  schedulers.
+
+  Segments are never returned to the operating system. Deallocated
+  segments are kept in per-size free lists and reused by later
+  allocations of the same size.
+*/
+
+namespace segmented_vector {
+class MappedSegmentStorage {
+    static const size_t CHUNK_BYTES = 16 * 1024 * 1024;
+
+    struct Chunk {
+        char *data;
+        size_t size;
+        size_t used;
+        bool resident;
+    };
+
+    const size_t max_resident_chunks;
+    std::string file_name;
+    int fd;
+    size_t file_size;
+
+    std::vector<Chunk> chunks;
+    // Indices of resident chunks, least recently used first.
+    std::vector<int> resident_chunks;
+    std::unordered_map<size_t, std::vector<std::pair<void *, int>>> free_segments;
+
+    int num_allocated_segments;
+    int num_reused_segments;
+    int num_page_outs;
+
+    int add_chunk(size_t min_size);
+    void mark_used(int chunk_id);
+    void page_out(int chunk_id);
+    int find_chunk(const void *ptr) const;
+public:
+    MappedSegmentStorage(const std::string &directory, int max_resident_mb);
+    ~MappedSegmentStorage();
+
+    MappedSegmentStorage(const MappedSegmentStorage &) = delete;
+    MappedSegmentStorage &operator=(const MappedSegmentStorage &) = delete;
+
+    void *allocate(size_t bytes);
+    // Return false if the given memory was not allocated by this storage.
+    bool deallocate(void *ptr, size_t bytes);
+
+    void print_statistics() const;
+};
+
+extern void set_segment_storage(std::unique_ptr<MappedSegmentStorage> storage);
+extern MappedSegmentStorage *get_segment_storage();
+
+extern void *allocate_segment(size_t bytes);
+extern void deallocate_segment(void *ptr, size_t bytes);
+
+/*
+  Allocator used by default for the segments of SegmentedVector and
+  SegmentedArrayVector. It forwards to the installed segment storage (if
+  any) and to the heap otherwise.
+*/
+template<class T>
+class SegmentAllocator {
+public:
+    using value_type = T;
+
+    template<class U>
+    struct rebind {
+        using other = SegmentAllocator<U>;
+    };
+
+    SegmentAllocator() = default;
+
+    template<class U>
+    SegmentAllocator(const SegmentAllocator<U> &) {
+    }
+
+    T *allocate(size_t n) {
+        return static_cast<T *>(allocate_segment(n * sizeof(T)));
+    }
+
+    void deallocate(T *ptr, size_t n) {
+        deallocate_segment(ptr, n * sizeof(T));
+    }
+
+    template<class U, class ... Args>
+    void construct(U *ptr, Args && ... args) {
+        ::new(static_cast<void *>(ptr))U(std::forward<Args>(args) ...);
+    }
+
+    template<class U>
+    void destroy(U *ptr) {
+        ptr->~U();
+    }
+};
+
+template<class T, class U>
+bool operator==(const SegmentAllocator<T> &, const SegmentAllocator<U> &) {
+    return true;
+}
+
+template<class T, class U>
+bool operator!=(const SegmentAllocator<T> &, const SegmentAllocator<U> &) {
+    return false;
+}
+}
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef ALGORITHMS_SEGMENTED_VECTOR_H
 #define ALGORITHMS_SEGMENTED_VECTOR_H
 
+#include "segment_storage.h"
+
 #include <algorithm>
 #include <cassert>
 #include <iostream>
@@ -35,6 +37,10 @@
   storing many fixed-size arrays. It's essentially a variant of SegmentedVector
   where the size of the stored data is only known at runtime, not at compile
   time.
+
+  By default, segments are allocated through SegmentAllocator, which places
+  them on the heap or, if configured, in memory-mapped files on disk (see
+  segment_storage.h).
 */
 
 // TODO: Get rid of the code duplication here. How to do it without
@@ -44,7 +50,7 @@
 // states see the file state_registry.h.
 
 namespace segmented_vector {
-template<class Entry, class Allocator = std::allocator<Entry>>
+template<class Entry, class Allocator = SegmentAllocator<Entry>>
 class SegmentedVector {
     typedef typename Allocator::template rebind<Entry>::other EntryAllocator;
     // TODO: Try to find a good value for SEGMENT_BYTES.
@@ -146,7 +152,7 @@ public:
 };
 
 
-template<class Element, class Allocator = std::allocator<Element>>
+template<class Element, class Allocator = SegmentAllocator<Element>>
 class SegmentedArrayVector {
     typedef typename Allocator::template rebind<Element>::other ElementAllocator;
     // TODO: Try to find a good value for SEGMENT_BYTES.
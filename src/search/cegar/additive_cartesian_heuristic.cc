@@ -13,7 +13,6 @@
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
 
-#include <cassert>
 
 using namespace std;
 
@@ -31,6 +30,7 @@ static vector<CartesianHeuristicFunction> generate_heuristic_functions(
         opts.get<int>("max_transitions"),
         opts.get<double>("max_time"),
         opts.get<bool>("use_general_costs"),
+        opts.get<CostPartitioning>("cost_partitioning"),
         opts.get<PickSplit>("pick"),
         *rng,
         opts.get<bool>("debug"));
@@ -46,15 +46,11 @@ AdditiveCartesianHeuristic::AdditiveCartesianHeuristic(
 
 int AdditiveCartesianHeuristic::compute_heuristic(const State &ancestor_state) {
     State state = convert_ancestor_state(ancestor_state);
-    int sum_h = 0;
-    for (const CartesianHeuristicFunction &function : heuristic_functions) {
-        int value = function.get_value(state);
-        assert(value >= 0);
-        if (value == INF)
-            return DEAD_END;
-        sum_h += value;
-    }
-    assert(sum_h >= 0);
+    state.unpack();
+    int sum_h = compute_sum_of_values(
+        heuristic_functions, state.get_unpacked_values());
+    if (sum_h == INF)
+        return DEAD_END;
     return sum_h;
 }
 
@@ -135,6 +131,24 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
         "use_general_costs",
         "allow negative costs in cost partitioning",
         "true");
+    vector<string> cost_partitionings;
+    vector<string> cost_partitioning_docs;
+    cost_partitionings.push_back("SATURATED");
+    cost_partitioning_docs.push_back(
+        "refine the subtasks one after the other, each with the costs that "
+        "the previous abstractions leave unused");
+    cost_partitionings.push_back("UNIFORM");
+    cost_partitioning_docs.push_back(
+        "split the remaining costs evenly between the subtasks of a "
+        "generator and refine them independently, in parallel if --threads "
+        "is larger than 1. The costs that the abstractions leave unused "
+        "go to the subtasks of the next generator");
+    parser.add_enum_option<CostPartitioning>(
+        "cost_partitioning",
+        cost_partitionings,
+        "how the subtasks of a generator share the operator costs",
+        "SATURATED",
+        cost_partitioning_docs);
     parser.add_option<bool>(
         "debug",
         "print debugging output",
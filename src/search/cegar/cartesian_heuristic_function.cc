@@ -1,22 +1,178 @@
 #include "cartesian_heuristic_function.h"
 
 #include "refinement_hierarchy.h"
+#include "types.h"
+
+#include "../abstract_task.h"
+#include "../task_proxy.h"
 
 #include "../utils/collections.h"
+#include "../utils/hash.h"
+#include "../utils/system.h"
+
+#include <algorithm>
+#include <deque>
+#include <iostream>
 
 using namespace std;
 
 namespace cegar {
+/*
+  Return the value in task for each variable and value of the ancestor
+  task. All task transformations used for CEGAR subtasks keep the
+  variables and convert the value of each variable independently of the
+  other variables, so we can convert the values of all variables at once.
+*/
+static vector<vector<int>> get_value_mapping(
+    const AbstractTask &task, const AbstractTask &ancestor_task) {
+    int num_variables = ancestor_task.get_num_variables();
+    if (task.get_num_variables() != num_variables) {
+        cerr << "Cartesian abstractions need subtasks with the same "
+             << "variables as the task of the heuristic." << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+    int max_domain_size = 0;
+    for (int var = 0; var < num_variables; ++var) {
+        max_domain_size = max(
+            max_domain_size, ancestor_task.get_variable_domain_size(var));
+    }
+    vector<vector<int>> value_mapping(num_variables);
+    vector<int> values(num_variables);
+    for (int value = 0; value < max_domain_size; ++value) {
+        for (int var = 0; var < num_variables; ++var) {
+            values[var] = min(
+                value, ancestor_task.get_variable_domain_size(var) - 1);
+        }
+        task.convert_state_values(values, &ancestor_task);
+        for (int var = 0; var < num_variables; ++var) {
+            if (value < ancestor_task.get_variable_domain_size(var)) {
+                assert(values[var] < task.get_variable_domain_size(var));
+                value_mapping[var].push_back(values[var]);
+            }
+        }
+    }
+    return value_mapping;
+}
+
 CartesianHeuristicFunction::CartesianHeuristicFunction(
-    unique_ptr<RefinementHierarchy> &&hierarchy,
-    vector<int> &&h_values)
-    : refinement_hierarchy(move(hierarchy)),
-      h_values(move(h_values)) {
+    const RefinementHierarchy &hierarchy,
+    const vector<int> &h_values,
+    const AbstractTask &ancestor_task)
+    : root(0) {
+    compile(hierarchy, h_values, ancestor_task);
+}
+
+void CartesianHeuristicFunction::compile(
+    const RefinementHierarchy &hierarchy,
+    const vector<int> &h_values,
+    const AbstractTask &ancestor_task) {
+    const AbstractTask &task = *hierarchy.get_task();
+    vector<vector<int>> value_mapping = get_value_mapping(task, ancestor_task);
+
+    /*
+      Map the hierarchy nodes reached so far to their entries. Helper
+      nodes within a chain are skipped and never get an entry.
+    */
+    utils::HashMap<NodeID, int> entries;
+    deque<NodeID> queue;
+    auto get_entry = [&](NodeID node_id) {
+        auto it = entries.find(node_id);
+        if (it != entries.end())
+            return it->second;
+        const Node &node = hierarchy.get_node(node_id);
+        int entry;
+        if (node.is_split()) {
+            entry = nodes.size();
+            int var = node.get_var();
+            nodes.push_back(var);
+            nodes.resize(nodes.size() + value_mapping[var].size(), 0);
+            queue.push_back(node_id);
+        } else {
+            int h = h_values[node.get_state_id()];
+            assert(h >= 0);
+            entry = ~h;
+        }
+        entries[node_id] = entry;
+        return entry;
+    };
+
+    root = get_entry(0);
+    vector<int> successors;
+    while (!queue.empty()) {
+        NodeID node_id = queue.front();
+        queue.pop_front();
+        int offset = entries[node_id];
+        int var = hierarchy.get_node(node_id).get_var();
+        int domain_size = task.get_variable_domain_size(var);
+        successors.assign(domain_size, 0);
+        for (int value = 0; value < domain_size; ++value) {
+            // Follow the chain of nodes that test the same variable.
+            NodeID successor_id = node_id;
+            while (true) {
+                const Node &successor = hierarchy.get_node(successor_id);
+                if (!successor.is_split() || successor.get_var() != var)
+                    break;
+                successor_id = successor.get_child(value);
+            }
+            successors[value] = get_entry(successor_id);
+        }
+        const vector<int> &ancestor_values = value_mapping[var];
+        for (size_t ancestor_value = 0; ancestor_value < ancestor_values.size();
+             ++ancestor_value) {
+            nodes[offset + 1 + ancestor_value] =
+                successors[ancestor_values[ancestor_value]];
+        }
+    }
+    nodes.shrink_to_fit();
 }
 
 int CartesianHeuristicFunction::get_value(const State &state) const {
-    int abstract_state_id = refinement_hierarchy->get_abstract_state_id(state);
-    assert(utils::in_bounds(abstract_state_id, h_values));
-    return h_values[abstract_state_id];
+    state.unpack();
+    const vector<int> &values = state.get_unpacked_values();
+    int entry = root;
+    while (entry >= 0) {
+        assert(utils::in_bounds(entry + 1 + values[nodes[entry]], nodes));
+        entry = nodes[entry + 1 + values[nodes[entry]]];
+    }
+    return ~entry;
+}
+
+int compute_sum_of_values(
+    const vector<CartesianHeuristicFunction> &functions,
+    const vector<int> &state_values) {
+    const int batch_size = 8;
+    const int *batch_nodes[batch_size];
+    int batch_entries[batch_size];
+    int num_functions = functions.size();
+    int sum = 0;
+    for (int start = 0; start < num_functions; start += batch_size) {
+        int num_lookups = min(batch_size, num_functions - start);
+        for (int i = 0; i < num_lookups; ++i) {
+            const CartesianHeuristicFunction &function = functions[start + i];
+            batch_nodes[i] = function.nodes.data();
+            batch_entries[i] = function.root;
+        }
+        bool done = false;
+        while (!done) {
+            done = true;
+            for (int i = 0; i < num_lookups; ++i) {
+                int entry = batch_entries[i];
+                if (entry >= 0) {
+                    const int *node = batch_nodes[i] + entry;
+                    batch_entries[i] = node[1 + state_values[node[0]]];
+                    done = false;
+                }
+            }
+        }
+        for (int i = 0; i < num_lookups; ++i) {
+            int value = ~batch_entries[i];
+            assert(value >= 0);
+            if (value == INF)
+                return INF;
+            sum += value;
+        }
+    }
+    assert(sum >= 0);
+    return sum;
 }
 }
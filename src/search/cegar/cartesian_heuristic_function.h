@@ -1,32 +1,66 @@
 #ifndef CEGAR_CARTESIAN_HEURISTIC_FUNCTION_H
 #define CEGAR_CARTESIAN_HEURISTIC_FUNCTION_H
 
-#include <memory>
 #include <vector>
 
+class AbstractTask;
 class State;
 
 namespace cegar {
 class RefinementHierarchy;
 /*
-  Store RefinementHierarchy and heuristic values for looking up abstract state
-  IDs and corresponding heuristic values efficiently.
+  Store the heuristic values of a Cartesian abstraction in a compiled form
+  of its RefinementHierarchy for looking them up efficiently.
+
+  The compiled form is a decision DAG over the variables of an ancestor
+  task of the abstraction's task, usually the task of the heuristic. Each
+  inner node tests one variable and stores the successor for each of its
+  values contiguously. Chains of helper nodes that split off several
+  values of the same variable become a single node, and the conversion of
+  state values from the ancestor task into the abstraction's task is
+  folded into the successor tables, so lookups need neither. Nodes are
+  stored in breadth-first order, so the nodes visited first by all
+  lookups are close to each other.
 */
 class CartesianHeuristicFunction {
-    // Avoid const to enable moving.
-    std::unique_ptr<RefinementHierarchy> refinement_hierarchy;
-    std::vector<int> h_values;
+    /*
+      An inner node at offset i tests variable nodes[i] and continues at
+      nodes[i + 1 + value] for the given value of the variable. Negative
+      entries ~h are leaves for abstract states with heuristic value h.
+    */
+    std::vector<int> nodes;
+    int root;
+
+    void compile(
+        const RefinementHierarchy &hierarchy,
+        const std::vector<int> &h_values,
+        const AbstractTask &ancestor_task);
 
 public:
     CartesianHeuristicFunction(
-        std::unique_ptr<RefinementHierarchy> &&hierarchy,
-        std::vector<int> &&h_values);
+        const RefinementHierarchy &hierarchy,
+        const std::vector<int> &h_values,
+        const AbstractTask &ancestor_task);
 
     CartesianHeuristicFunction(const CartesianHeuristicFunction &) = delete;
     CartesianHeuristicFunction(CartesianHeuristicFunction &&) = default;
 
+    // The state has to belong to the ancestor task given on construction.
     int get_value(const State &state) const;
+
+    /*
+      Return the sum of the values of all functions for the given state
+      values of the ancestor task, or INF if one of them is INF. Several
+      lookups are interleaved so that their memory accesses overlap.
+    */
+    friend int compute_sum_of_values(
+        const std::vector<CartesianHeuristicFunction> &functions,
+        const std::vector<int> &state_values);
 };
+
+extern int compute_sum_of_values(
+    const std::vector<CartesianHeuristicFunction> &functions,
+    const std::vector<int> &state_values);
 }
 
 #endif
@@ -14,9 +14,14 @@
 #include "../utils/countdown_timer.h"
 #include "../utils/logging.h"
 #include "../utils/memory.h"
+#include "../utils/rng.h"
+#include "../utils/thread_pool.h"
 
 #include <algorithm>
 #include <cassert>
+#include <iostream>
+#include <limits>
+#include <sstream>
 
 using namespace std;
 
@@ -80,6 +85,84 @@ static vector<int> compute_saturated_costs(
     return saturated_costs;
 }
 
+/*
+  Everything that cost saturation needs from an abstraction. The
+  abstraction itself can be freed once this is computed.
+*/
+struct SaturatedAbstraction {
+    CartesianHeuristicFunction heuristic_function;
+    vector<int> saturated_costs;
+    int num_states;
+    int num_non_looping_transitions;
+
+    SaturatedAbstraction(
+        CartesianHeuristicFunction &&heuristic_function,
+        vector<int> &&saturated_costs,
+        int num_states,
+        int num_non_looping_transitions)
+        : heuristic_function(move(heuristic_function)),
+          saturated_costs(move(saturated_costs)),
+          num_states(num_states),
+          num_non_looping_transitions(num_non_looping_transitions) {
+    }
+};
+
+static SaturatedAbstraction saturate(
+    unique_ptr<Abstraction> abstraction,
+    const vector<int> &costs,
+    bool use_general_costs,
+    const AbstractTask &ancestor_task) {
+    vector<int> init_distances = compute_distances(
+        abstraction->get_transition_system().get_outgoing_transitions(),
+        costs,
+        {abstraction->get_initial_state().get_id()});
+    vector<int> goal_distances = compute_distances(
+        abstraction->get_transition_system().get_incoming_transitions(),
+        costs,
+        abstraction->get_goals());
+    vector<int> saturated_costs = compute_saturated_costs(
+        abstraction->get_transition_system(),
+        init_distances,
+        goal_distances,
+        use_general_costs);
+    int num_states = abstraction->get_num_states();
+    int num_non_looping_transitions =
+        abstraction->get_transition_system().get_num_non_loops();
+    return SaturatedAbstraction(
+        CartesianHeuristicFunction(
+            *abstraction->extract_refinement_hierarchy(),
+            goal_distances,
+            ancestor_task),
+        move(saturated_costs),
+        num_states,
+        num_non_looping_transitions);
+}
+
+/*
+  Return the share of the given costs for subtask index of num_subtasks
+  subtasks. Operator op gets cost / num_subtasks in each subtask and one
+  extra unit in cost % num_subtasks of them, starting at subtask
+  op % num_subtasks, so that the shares add up to the cost. Infinite costs
+  stay infinite.
+*/
+static vector<int> get_uniform_costs(
+    const vector<int> &costs, int index, int num_subtasks) {
+    int num_operators = costs.size();
+    vector<int> shares(num_operators);
+    for (int op_id = 0; op_id < num_operators; ++op_id) {
+        int cost = costs[op_id];
+        if (cost == INF) {
+            shares[op_id] = INF;
+        } else {
+            int offset = (index - op_id % num_subtasks + num_subtasks) %
+                num_subtasks;
+            shares[op_id] = cost / num_subtasks +
+                (offset < cost % num_subtasks ? 1 : 0);
+        }
+    }
+    return shares;
+}
+
 
 CostSaturation::CostSaturation(
     const vector<shared_ptr<SubtaskGenerator>> &subtask_generators,
@@ -87,6 +170,7 @@ CostSaturation::CostSaturation(
     int max_non_looping_transitions,
     double max_time,
     bool use_general_costs,
+    CostPartitioning cost_partitioning,
     PickSplit pick_split,
     utils::RandomNumberGenerator &rng,
     bool debug)
@@ -95,6 +179,7 @@ CostSaturation::CostSaturation(
       max_non_looping_transitions(max_non_looping_transitions),
       max_time(max_time),
       use_general_costs(use_general_costs),
+      cost_partitioning(cost_partitioning),
       pick_split(pick_split),
       rng(rng),
       debug(debug),
@@ -131,7 +216,11 @@ vector<CartesianHeuristicFunction> CostSaturation::generate_heuristic_functions(
     utils::reserve_extra_memory_padding(memory_padding_in_mb);
     for (const shared_ptr<SubtaskGenerator> &subtask_generator : subtask_generators) {
         SharedTasks subtasks = subtask_generator->get_subtasks(task);
-        build_abstractions(subtasks, timer, should_abort);
+        if (cost_partitioning == CostPartitioning::UNIFORM) {
+            build_abstractions_uniformly(*task, subtasks, timer);
+        } else {
+            build_abstractions(*task, subtasks, timer, should_abort);
+        }
         if (should_abort())
             break;
     }
@@ -187,7 +276,22 @@ bool CostSaturation::state_is_dead_end(const State &state) const {
     return false;
 }
 
+void CostSaturation::add_heuristic_function(
+    SaturatedAbstraction &&saturated_abstraction) {
+    ++num_abstractions;
+    num_states += saturated_abstraction.num_states;
+    num_non_looping_transitions +=
+        saturated_abstraction.num_non_looping_transitions;
+    assert(num_states <= max_states);
+
+    heuristic_functions.push_back(
+        move(saturated_abstraction.heuristic_function));
+
+    reduce_remaining_costs(saturated_abstraction.saturated_costs);
+}
+
 void CostSaturation::build_abstractions(
+    const AbstractTask &task,
     const vector<shared_ptr<AbstractTask>> &subtasks,
     const utils::CountdownTimer &timer,
     function<bool()> should_abort) {
@@ -206,32 +310,12 @@ void CostSaturation::build_abstractions(
             rng,
             debug);
 
-        unique_ptr<Abstraction> abstraction = cegar.extract_abstraction();
-        ++num_abstractions;
-        num_states += abstraction->get_num_states();
-        num_non_looping_transitions += abstraction->get_transition_system().get_num_non_loops();
-        assert(num_states <= max_states);
-
-        vector<int> costs = task_properties::get_operator_costs(TaskProxy(*subtask));
-        vector<int> init_distances = compute_distances(
-            abstraction->get_transition_system().get_outgoing_transitions(),
-            costs,
-            {abstraction->get_initial_state().get_id()});
-        vector<int> goal_distances = compute_distances(
-            abstraction->get_transition_system().get_incoming_transitions(),
-            costs,
-            abstraction->get_goals());
-        vector<int> saturated_costs = compute_saturated_costs(
-            abstraction->get_transition_system(),
-            init_distances,
-            goal_distances,
-            use_general_costs);
-
-        heuristic_functions.emplace_back(
-            abstraction->extract_refinement_hierarchy(),
-            move(goal_distances));
-
-        reduce_remaining_costs(saturated_costs);
+        add_heuristic_function(
+            saturate(
+                cegar.extract_abstraction(),
+                task_properties::get_operator_costs(TaskProxy(*subtask)),
+                use_general_costs,
+                task));
 
         if (should_abort())
             break;
@@ -240,6 +324,82 @@ void CostSaturation::build_abstractions(
     }
 }
 
+void CostSaturation::build_abstractions_uniformly(
+    const AbstractTask &task,
+    const vector<shared_ptr<AbstractTask>> &subtasks,
+    const utils::CountdownTimer &timer) {
+    // Each abstraction has at least one state.
+    assert(num_states < max_states);
+    int num_subtasks = min(
+        static_cast<int>(subtasks.size()), max_states - num_states);
+    if (num_subtasks == 0)
+        return;
+
+    int max_states_per_subtask = (max_states - num_states) / num_subtasks;
+    int max_transitions_per_subtask = max(
+        1, (max_non_looping_transitions - num_non_looping_transitions) /
+        num_subtasks);
+    /*
+      With k threads, the abstractions are built in about num_subtasks / k
+      rounds, so each of them may use k / num_subtasks of the remaining time.
+    */
+    double remaining_time = timer.get_remaining_time();
+    double max_time_per_subtask = min(
+        remaining_time,
+        remaining_time * utils::get_available_num_threads() / num_subtasks);
+
+    /*
+      The jobs must not share the random number generator. Seeding their
+      generators in a fixed order keeps the result independent of the
+      number of threads.
+    */
+    vector<int> seeds;
+    seeds.reserve(num_subtasks);
+    for (int i = 0; i < num_subtasks; ++i) {
+        seeds.push_back(rng(numeric_limits<int>::max()));
+    }
+
+    /*
+      The jobs only keep what cost saturation needs from their
+      abstractions. Their output is printed in the order of the subtasks
+      once all of them are done.
+    */
+    vector<unique_ptr<SaturatedAbstraction>> saturated_abstractions(
+        num_subtasks);
+    vector<string> logs(num_subtasks);
+    utils::run_in_parallel(
+        num_subtasks, [&](int i, int) {
+            vector<int> costs = get_uniform_costs(
+                remaining_costs, i, num_subtasks);
+            shared_ptr<AbstractTask> subtask =
+                make_shared<extra_tasks::ModifiedOperatorCostsTask>(
+                    subtasks[i], vector<int>(costs));
+            ostringstream log;
+            {
+                utils::LogRedirection redirection(log);
+                utils::RandomNumberGenerator subtask_rng(seeds[i]);
+                CEGAR cegar(
+                    subtask,
+                    max_states_per_subtask,
+                    max_transitions_per_subtask,
+                    max_time_per_subtask,
+                    pick_split,
+                    subtask_rng,
+                    debug);
+                saturated_abstractions[i] =
+                    utils::make_unique_ptr<SaturatedAbstraction>(
+                        saturate(cegar.extract_abstraction(), costs,
+                                 use_general_costs, task));
+            }
+            logs[i] = log.str();
+        });
+
+    for (int i = 0; i < num_subtasks; ++i) {
+        cout << logs[i];
+        add_heuristic_function(move(*saturated_abstractions[i]));
+    }
+}
+
 void CostSaturation::print_statistics(utils::Duration init_time) const {
     utils::g_log << "Done initializing additive Cartesian heuristic" << endl;
     utils::g_log << "Time for initializing additive Cartesian heuristic: "
@@ -15,14 +15,29 @@ class RandomNumberGenerator;
 
 namespace cegar {
 class CartesianHeuristicFunction;
+struct SaturatedAbstraction;
 class SubtaskGenerator;
 
+enum class CostPartitioning {
+    /*
+      Refine the subtasks one after the other, each with the costs that
+      the previous abstractions leave unused.
+    */
+    SATURATED,
+    /*
+      Split the remaining costs of each operator evenly (up to rounding)
+      between the subtasks of a generator. Their abstractions are
+      independent and are built in parallel. The costs they leave unused
+      go to the next generator.
+    */
+    UNIFORM
+};
+
 /*
   Get subtasks from SubtaskGenerators, reduce their costs by wrapping
-  them in ModifiedOperatorCostsTasks, compute Abstractions, move
-  RefinementHierarchies from Abstractions to
-  CartesianHeuristicFunctions, allow extracting
-  CartesianHeuristicFunctions into AdditiveCartesianHeuristic.
+  them in ModifiedOperatorCostsTasks, compute Abstractions, compile
+  their RefinementHierarchies into CartesianHeuristicFunctions, allow
+  extracting CartesianHeuristicFunctions into AdditiveCartesianHeuristic.
 */
 class CostSaturation {
     const std::vector<std::shared_ptr<SubtaskGenerator>> subtask_generators;
@@ -30,6 +45,7 @@ class CostSaturation {
     const int max_non_looping_transitions;
     const double max_time;
     const bool use_general_costs;
+    const CostPartitioning cost_partitioning;
     const PickSplit pick_split;
     utils::RandomNumberGenerator &rng;
     const bool debug;
@@ -45,10 +61,16 @@ class CostSaturation {
     std::shared_ptr<AbstractTask> get_remaining_costs_task(
         std::shared_ptr<AbstractTask> &parent) const;
     bool state_is_dead_end(const State &state) const;
+    void add_heuristic_function(SaturatedAbstraction &&saturated_abstraction);
     void build_abstractions(
+        const AbstractTask &task,
         const std::vector<std::shared_ptr<AbstractTask>> &subtasks,
         const utils::CountdownTimer &timer,
         std::function<bool()> should_abort);
+    void build_abstractions_uniformly(
+        const AbstractTask &task,
+        const std::vector<std::shared_ptr<AbstractTask>> &subtasks,
+        const utils::CountdownTimer &timer);
     void print_statistics(utils::Duration init_time) const;
 
 public:
@@ -58,6 +80,7 @@ public:
         int max_non_looping_transitions,
         double max_time,
         bool use_general_costs,
+        CostPartitioning cost_partitioning,
         PickSplit pick_split,
         utils::RandomNumberGenerator &rng,
         bool debug);
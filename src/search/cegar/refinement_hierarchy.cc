@@ -1,6 +1,6 @@
 #include "refinement_hierarchy.h"
 
-#include "../task_proxy.h"
+#include "../utils/collections.h"
 
 using namespace std;
 
@@ -56,15 +56,6 @@ NodeID RefinementHierarchy::add_node(int state_id) {
     return node_id;
 }
 
-NodeID RefinementHierarchy::get_node_id(const State &state) const {
-    NodeID id = 0;
-    while (nodes[id].is_split()) {
-        const Node &node = nodes[id];
-        id = node.get_child(state[node.get_var()].get_value());
-    }
-    return id;
-}
-
 pair<NodeID, NodeID> RefinementHierarchy::split(
     NodeID node_id, int var, const vector<int> &values, int left_state_id, int right_state_id) {
     NodeID helper_id = node_id;
@@ -77,9 +68,8 @@ pair<NodeID, NodeID> RefinementHierarchy::split(
     return make_pair(helper_id, right_child_id);
 }
 
-int RefinementHierarchy::get_abstract_state_id(const State &state) const {
-    TaskProxy subtask_proxy(*task);
-    State subtask_state = subtask_proxy.convert_ancestor_state(state);
-    return nodes[get_node_id(subtask_state)].get_state_id();
+const Node &RefinementHierarchy::get_node(NodeID node_id) const {
+    assert(utils::in_bounds(node_id, nodes));
+    return nodes[node_id];
 }
 }
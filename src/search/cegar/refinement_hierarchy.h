@@ -10,7 +10,6 @@
 #include <vector>
 
 class AbstractTask;
-class State;
 
 namespace cegar {
 class Node;
@@ -20,7 +19,8 @@ class Node;
   abstraction. The hierarchy forms a DAG with inner nodes for each
   split and leaf nodes for the abstract states.
 
-  It is used for efficient lookup of abstract states during search.
+  CartesianHeuristicFunction compiles it into a compact structure for
+  efficient lookup of abstract states during search.
 
   Inner nodes correspond to abstract states that have been split (or
   helper nodes, see below). Leaf nodes correspond to the current
@@ -32,7 +32,6 @@ class RefinementHierarchy {
     std::vector<Node> nodes;
 
     NodeID add_node(int state_id);
-    NodeID get_node_id(const State &state) const;
 
 public:
     explicit RefinementHierarchy(const std::shared_ptr<AbstractTask> &task);
@@ -47,7 +46,12 @@ public:
         NodeID node_id, int var, const std::vector<int> &values,
         int left_state_id, int right_state_id);
 
-    int get_abstract_state_id(const State &state) const;
+    const std::shared_ptr<AbstractTask> &get_task() const {
+        return task;
+    }
+
+    // The root node has ID 0.
+    const Node &get_node(NodeID node_id) const;
 };
 
 
@@ -1,13 +1,20 @@
 #include "command_line.h"
 
+#include "disk_cache.h"
 #include "option_parser.h"
 #include "plan_manager.h"
+#include "search_checkpoint.h"
 #include "search_engine.h"
 
+#include "algorithms/segment_storage.h"
 #include "options/doc_printer.h"
 #include "options/predefinitions.h"
 #include "options/registries.h"
+#include "tasks/root_task.h"
+#include "utils/memory.h"
 #include "utils/strings.h"
+#include "utils/system.h"
+#include "utils/thread_pool.h"
 
 #include <algorithm>
 #include <vector>
@@ -46,8 +53,25 @@ static shared_ptr<SearchEngine> parse_cmd_line_aux(
     string plan_filename = "sas_plan";
     int num_previously_generated_plans = 0;
     bool is_part_of_anytime_portfolio = false;
+    string segment_storage_dir;
+    int segment_storage_resident_mb = 512;
+    string checkpoint_file;
+    int checkpoint_interval = 600;
+    string binary_task_file;
+    int num_threads = 1;
+    string cache_dir;
     options::Predefinitions predefinitions;
 
+    /*
+      Parsing the search configuration and predefinitions constructs
+      heuristics, which may already use global settings such as the number
+      of threads or the cache directory (e.g. for building pattern
+      databases). We therefore
+      remember the positions of these arguments and process them in their
+      original order after all other options have been read.
+    */
+    vector<size_t> configuration_args;
+
     shared_ptr<SearchEngine> engine;
     /*
       Note that we don’t sanitize all arguments beforehand because filenames should remain as-is
@@ -60,10 +84,8 @@ static shared_ptr<SearchEngine> parse_cmd_line_aux(
         if (arg == "--search") {
             if (is_last)
                 throw ArgError("missing argument after --search");
+            configuration_args.push_back(i);
             ++i;
-            OptionParser parser(sanitize_arg_string(args[i]), registry,
-                                predefinitions, dry_run);
-            engine = parser.start_parsing<shared_ptr<SearchEngine>>();
         } else if (arg == "--help" && dry_run) {
             cout << "Help:" << endl;
             bool txt2tags = false;
@@ -105,19 +127,101 @@ static shared_ptr<SearchEngine> parse_cmd_line_aux(
             num_previously_generated_plans = parse_int_arg(arg, args[i]);
             if (num_previously_generated_plans < 0)
                 throw ArgError("argument for --internal-previous-portfolio-plans must be positive");
+        } else if (arg == "--segment-storage-dir") {
+            if (is_last)
+                throw ArgError("missing argument after --segment-storage-dir");
+            ++i;
+            segment_storage_dir = args[i];
+        } else if (arg == "--segment-storage-resident-mb") {
+            if (is_last)
+                throw ArgError("missing argument after --segment-storage-resident-mb");
+            ++i;
+            segment_storage_resident_mb = parse_int_arg(arg, args[i]);
+            if (segment_storage_resident_mb <= 0)
+                throw ArgError("argument for --segment-storage-resident-mb must be positive");
+        } else if (arg == "--write-binary-task") {
+            if (is_last)
+                throw ArgError("missing argument after --write-binary-task");
+            ++i;
+            binary_task_file = args[i];
+        } else if (arg == "--checkpoint") {
+            if (is_last)
+                throw ArgError("missing argument after --checkpoint");
+            ++i;
+            checkpoint_file = args[i];
+        } else if (arg == "--checkpoint-interval") {
+            if (is_last)
+                throw ArgError("missing argument after --checkpoint-interval");
+            ++i;
+            checkpoint_interval = parse_int_arg(arg, args[i]);
+            if (checkpoint_interval <= 0)
+                throw ArgError("argument for --checkpoint-interval must be positive");
+        } else if (arg == "--cache-dir") {
+            if (is_last)
+                throw ArgError("missing argument after --cache-dir");
+            ++i;
+            cache_dir = args[i];
+        } else if (arg == "--threads") {
+            if (is_last)
+                throw ArgError("missing argument after --threads");
+            ++i;
+            num_threads = parse_int_arg(arg, args[i]);
+            if (num_threads <= 0)
+                throw ArgError("argument for --threads must be positive");
         } else if (utils::startswith(arg, "--") &&
                    registry.is_predefinition(arg.substr(2))) {
             if (is_last)
                 throw ArgError("missing argument after " + arg);
+            configuration_args.push_back(i);
             ++i;
-            registry.handle_predefinition(arg.substr(2),
-                                          sanitize_arg_string(args[i]),
-                                          predefinitions, dry_run);
         } else {
             throw ArgError("unknown option " + arg);
         }
     }
 
+    if (!dry_run && num_threads > 1) {
+        utils::set_num_threads(num_threads);
+    }
+
+    if (!dry_run && !cache_dir.empty()) {
+        disk_cache::set_cache_directory(cache_dir);
+    }
+
+    for (size_t i : configuration_args) {
+        string arg = sanitize_arg_string(args[i]);
+        string value = sanitize_arg_string(args[i + 1]);
+        if (arg == "--search") {
+            OptionParser parser(value, registry, predefinitions, dry_run);
+            engine = parser.start_parsing<shared_ptr<SearchEngine>>();
+        } else {
+            registry.handle_predefinition(arg.substr(2), value,
+                                          predefinitions, dry_run);
+        }
+    }
+
+    /*
+      Segments are only allocated once the search starts, so it does not
+      matter that the engine has already been created at this point.
+    */
+    if (!dry_run && !segment_storage_dir.empty()) {
+        segmented_vector::set_segment_storage(
+            utils::make_unique_ptr<segmented_vector::MappedSegmentStorage>(
+                segment_storage_dir, segment_storage_resident_mb));
+    }
+
+    if (!dry_run && !binary_task_file.empty()) {
+        tasks::write_binary_root_task(binary_task_file);
+        if (!engine) {
+            // Only convert the task.
+            utils::exit_with(utils::ExitCode::SUCCESS);
+        }
+    }
+
+    if (!dry_run && !checkpoint_file.empty()) {
+        search_checkpoint::set_checkpoint_options(
+            checkpoint_file, checkpoint_interval);
+    }
+
     if (engine) {
         PlanManager &plan_manager = engine->get_plan_manager();
         plan_manager.set_plan_filename(plan_filename);
@@ -171,5 +275,28 @@ string usage(const string &progname) {
            "    This planner call is part of a portfolio which already created\n"
            "    plan files FILENAME.1 up to FILENAME.COUNTER.\n"
            "    Start enumerating plan files with COUNTER+1, i.e. FILENAME.COUNTER+1\n\n"
+           "--segment-storage-dir DIRECTORY\n"
+           "    Store the state registry and per-state information in\n"
+           "    memory-mapped files in DIRECTORY instead of RAM.\n"
+           "--segment-storage-resident-mb MB\n"
+           "    Keep at most about MB megabytes of memory-mapped segments\n"
+           "    resident (default: 512).\n\n"
+           "--write-binary-task FILENAME\n"
+           "    Write the task in a binary format that can be loaded much\n"
+           "    faster than the translator output. Without --search, the\n"
+           "    planner stops after writing the file.\n\n"
+           "--checkpoint FILENAME\n"
+           "    Periodically save the progress of the search to files starting\n"
+           "    with FILENAME and resume from them when called again.\n"
+           "--checkpoint-interval SECONDS\n"
+           "    Save the progress every SECONDS seconds (default: 600).\n\n"
+           "--cache-dir DIRECTORY\n"
+           "    Store expensive precomputations (currently pattern databases\n"
+           "    and merge-and-shrink heuristics) in DIRECTORY and reuse them\n"
+           "    in later runs on the same task.\n\n"
+           "--threads N\n"
+           "    Evaluate the successors of an expanded state with N threads\n"
+           "    (default: 1). Only some heuristics (currently lmcut) compute\n"
+           "    their values in parallel.\n\n"
            "See http://www.fast-downward.org/ for details.";
 }
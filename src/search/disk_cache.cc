@@ -0,0 +1,65 @@
+#include "disk_cache.h"
+
+#include "utils/system.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+
+namespace disk_cache {
+static string cache_directory;
+// Entries may be written concurrently by several threads.
+static atomic<int> num_tmp_files(0);
+static atomic<bool> reported_write_error(false);
+
+void set_cache_directory(const string &directory) {
+    cache_directory = directory;
+}
+
+bool cache_is_enabled() {
+    return !cache_directory.empty();
+}
+
+string get_cache_file(const string &kind, uint64_t key) {
+    assert(cache_is_enabled());
+    ostringstream file_name;
+    file_name << cache_directory << "/" << kind << "-"
+              << hex << setw(16) << setfill('0') << key;
+    return file_name.str();
+}
+
+CacheWriter::CacheWriter(const string &file_name)
+    : file_name(file_name),
+      tmp_file_name(file_name + ".tmp" + to_string(utils::get_process_id()) +
+                    "-" + to_string(num_tmp_files++)),
+      stream(tmp_file_name, ios::binary | ios::trunc) {
+}
+
+CacheWriter::~CacheWriter() {
+    if (stream.is_open()) {
+        // The entry has not been committed.
+        stream.close();
+        remove(tmp_file_name.c_str());
+    }
+}
+
+bool CacheWriter::commit() {
+    bool written = stream.is_open();
+    stream.close();
+    written = written && !stream.fail() &&
+        rename(tmp_file_name.c_str(), file_name.c_str()) == 0;
+    if (!written) {
+        remove(tmp_file_name.c_str());
+        if (!reported_write_error.exchange(true)) {
+            cerr << "Warning: could not write cache file " << file_name
+                 << "; further errors are not reported." << endl;
+        }
+    }
+    return written;
+}
+}
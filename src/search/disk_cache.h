@@ -0,0 +1,63 @@
+#ifndef DISK_CACHE_H
+#define DISK_CACHE_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/*
+  The disk cache stores expensive precomputations (e.g., pattern
+  databases) in files, so that later planner runs on the same task can
+  reuse them instead of computing them again.
+
+  The cache is enabled with the command-line option --cache-dir DIRECTORY.
+  Every cache entry is identified by a kind (e.g., "pdb") and a 64-bit key
+  that hashes everything the precomputed data depends on. Users of the
+  cache must store enough information in the entry to detect invalid or
+  foreign files and should fall back to computing the data in that case.
+
+  Entries are written to a temporary file that is renamed once it is
+  complete, so concurrent planner runs sharing a cache directory never see
+  partially written entries. Failing to write an entry only produces a
+  warning because the cache is an optimization.
+*/
+
+namespace disk_cache {
+extern void set_cache_directory(const std::string &directory);
+extern bool cache_is_enabled();
+extern std::string get_cache_file(const std::string &kind, uint64_t key);
+
+class CacheWriter {
+    std::string file_name;
+    std::string tmp_file_name;
+    std::ofstream stream;
+
+public:
+    explicit CacheWriter(const std::string &file_name);
+    ~CacheWriter();
+
+    template<typename T>
+    void write(const T &value) {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "only trivially copyable types can be written");
+        stream.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    void write_array(const T *values, size_t size) {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "only trivially copyable types can be written");
+        stream.write(reinterpret_cast<const char *>(values), size * sizeof(T));
+    }
+
+    /*
+      Flush the entry and make it visible under its final name. Returns
+      false (after printing a warning) if the entry could not be written.
+    */
+    bool commit();
+};
+}
+
+#endif
@@ -9,10 +9,10 @@
 using namespace std;
 
 EvaluationContext::EvaluationContext(
-    const EvaluatorCache &cache, const State &state, int g_value,
+    EvaluatorCache &&cache, const State &state, int g_value,
     bool is_preferred, SearchStatistics *statistics,
     bool calculate_preferred, EstimationInfo *g_estimation_ptr)
-    : cache(cache),
+    : cache(move(cache)),
       state(state),
       g_value(g_value),
       preferred(is_preferred),
@@ -31,7 +31,7 @@ EvaluationContext::EvaluationContext(
     const EvaluationContext &other, int g_value,
     bool is_preferred, SearchStatistics *statistics, 
     bool calculate_preferred, EstimationInfo *g_estimation_ptr)
-    : EvaluationContext(other.cache, other.state, g_value, is_preferred,
+    : EvaluationContext(EvaluatorCache(other.cache), other.state, g_value, is_preferred,
                         statistics, calculate_preferred, g_estimation_ptr) {
 }
 
@@ -52,16 +52,25 @@ EvaluationContext::EvaluationContext(
 }
 
 const EvaluationResult &EvaluationContext::get_result(Evaluator *evaluator) {
-    EvaluationResult &result = cache[evaluator];
-    if (result.is_uninitialized()) {
-        result = evaluator->compute_result(*this);
-        if (statistics &&
-            evaluator->is_used_for_counting_evaluations() &&
-            result.get_count_evaluation()) {
-            statistics->inc_evaluations();
-        }
+    if (!has_result(evaluator))
+        set_result(evaluator, evaluator->compute_result(*this));
+    return cache[evaluator];
+}
+
+bool EvaluationContext::has_result(Evaluator *evaluator) {
+    return !cache[evaluator].is_uninitialized();
+}
+
+void EvaluationContext::set_result(
+    Evaluator *evaluator, EvaluationResult &&result) {
+    assert(!has_result(evaluator));
+    assert(!result.is_uninitialized());
+    if (statistics &&
+        evaluator->is_used_for_counting_evaluations() &&
+        result.get_count_evaluation()) {
+        statistics->inc_evaluations();
     }
-    return result;
+    cache[evaluator] = move(result);
 }
 
 const EvaluatorCache &EvaluationContext::get_cache() const {
@@ -53,7 +53,7 @@ class EvaluationContext {
     static const int INVALID = -1;
 
     EvaluationContext(
-        const EvaluatorCache &cache, const State &state, int g_value,
+        EvaluatorCache &&cache, const State &state, int g_value,
         bool is_preferred, SearchStatistics *statistics,
         bool calculate_preferred, EstimationInfo *g_estimation_ptr);
 public:
@@ -93,6 +93,13 @@ public:
         EstimationInfo *g_estimation_ptr = nullptr);
 
     const EvaluationResult &get_result(Evaluator *eval);
+    bool has_result(Evaluator *eval);
+    /*
+      Store a result that was computed outside of get_result, e.g., in a
+      batch (see Evaluator::compute_results). It is counted in the
+      statistics like a result computed by get_result.
+    */
+    void set_result(Evaluator *eval, EvaluationResult &&result);
     const EvaluatorCache &get_cache() const;
     const State &get_state() const;
     int get_g_value() const;
@@ -1,5 +1,6 @@
 #include "evaluator.h"
 
+#include "evaluation_context.h"
 #include "option_parser.h"
 #include "plugin.h"
 
@@ -7,24 +8,67 @@
 #include "utils/system.h"
 
 #include <cassert>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <vector>
 
 using namespace std;
 
+/*
+  The ID pool is intentionally never destroyed because evaluators may be
+  destroyed during static destruction at program exit. Parallel jobs may
+  create evaluators (e.g., CEGAR split selectors), so the pool is locked.
+*/
+struct EvaluatorIDPool {
+    mutex pool_mutex;
+    int num_ids = 0;
+    priority_queue<int, vector<int>, greater<int>> free_ids;
+};
+
+static EvaluatorIDPool &get_evaluator_id_pool() {
+    static EvaluatorIDPool *pool = new EvaluatorIDPool();
+    return *pool;
+}
+
+static int allocate_evaluator_id() {
+    EvaluatorIDPool &pool = get_evaluator_id_pool();
+    lock_guard<mutex> lock(pool.pool_mutex);
+    if (pool.free_ids.empty()) {
+        return pool.num_ids++;
+    }
+    int id = pool.free_ids.top();
+    pool.free_ids.pop();
+    return id;
+}
 
 Evaluator::Evaluator(const string &description,
                      bool use_for_reporting_minima,
                      bool use_for_boosting,
                      bool use_for_counting_evaluations)
-    : description(description),
+    : id(allocate_evaluator_id()),
+      description(description),
       use_for_reporting_minima(use_for_reporting_minima),
       use_for_boosting(use_for_boosting),
       use_for_counting_evaluations(use_for_counting_evaluations) {
 }
 
+Evaluator::~Evaluator() {
+    EvaluatorIDPool &pool = get_evaluator_id_pool();
+    lock_guard<mutex> lock(pool.pool_mutex);
+    pool.free_ids.push(id);
+}
+
 bool Evaluator::dead_ends_are_reliable() const {
     return true;
 }
 
+void Evaluator::compute_results(
+    const vector<EvaluationContext *> &eval_contexts) {
+    for (EvaluationContext *eval_context : eval_contexts)
+        eval_context->get_result(this);
+}
+
 void Evaluator::report_value_for_initial_state(const EvaluationResult &result) const {
     assert(use_for_reporting_minima);
     utils::g_log << "Initial heuristic value for " << description << ": ";
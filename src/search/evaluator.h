@@ -4,11 +4,18 @@
 #include "evaluation_result.h"
 
 #include <set>
+#include <vector>
 
 class EvaluationContext;
 class State;
 
 class Evaluator {
+    /*
+      Dense integer ID of this evaluator. IDs of destroyed evaluators are
+      recycled, so the IDs of all live evaluators stay small and can be
+      used to index per-evaluator arrays (see EvaluatorCache).
+    */
+    const int id;
     const std::string description;
     const bool use_for_reporting_minima;
     const bool use_for_boosting;
@@ -20,7 +27,7 @@ public:
         bool use_for_reporting_minima = false,
         bool use_for_boosting = false,
         bool use_for_counting_evaluations = false);
-    virtual ~Evaluator() = default;
+    virtual ~Evaluator();
 
     /*
       dead_ends_are_reliable should return true if the evaluator is
@@ -76,9 +83,29 @@ public:
     virtual EvaluationResult compute_result(
         EvaluationContext &eval_context) = 0;
 
+    /*
+      compute_results makes sure that the results of this evaluator are
+      cached in all given evaluation contexts, e.g., the contexts of all
+      successors of an expansion. Evaluators can override it to evaluate
+      the batch more efficiently than one context after the other, e.g.,
+      in parallel (see Heuristic::compute_results). Evaluators depending on
+      other evaluators should first pass the batch on to them.
+
+      Since the batch is evaluated completely, some evaluators may be
+      evaluated for states for which a sequential evaluation would have
+      stopped early, e.g., because another evaluator detected a dead end.
+
+      The default implementation evaluates the contexts in order.
+    */
+    virtual void compute_results(
+        const std::vector<EvaluationContext *> &eval_contexts);
+
     void report_value_for_initial_state(const EvaluationResult &result) const;
     void report_new_minimum_value(const EvaluationResult &result) const;
 
+    int get_id() const {
+        return id;
+    }
     const std::string &get_description() const;
     bool is_used_for_reporting_minima() const;
     bool is_used_for_boosting() const;
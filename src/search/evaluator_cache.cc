@@ -3,6 +3,11 @@
 using namespace std;
 
 
-EvaluationResult &EvaluatorCache::operator[](Evaluator *eval) {
-    return eval_results[eval];
+EvaluatorCache::Entry &EvaluatorCache::get_overflow_entry(int id) {
+    int index = id - INLINE_CAPACITY;
+    assert(index >= 0);
+    if (index >= static_cast<int>(overflow_entries.size())) {
+        overflow_entries.resize(index + 1);
+    }
+    return overflow_entries[index];
 }
@@ -2,28 +2,56 @@
 #define EVALUATOR_CACHE_H
 
 #include "evaluation_result.h"
+#include "evaluator.h"
 
-#include <unordered_map>
-
-class Evaluator;
-
-using EvaluationResults = std::unordered_map<Evaluator *, EvaluationResult>;
+#include <array>
+#include <cassert>
+#include <vector>
 
 /*
   Store evaluation results for evaluators.
+
+  Results are stored in a flat array indexed by the dense evaluator IDs
+  (see Evaluator::get_id). The first INLINE_CAPACITY slots live inside
+  the cache object itself, so creating a cache (and hence an evaluation
+  context) does not allocate memory for typical configurations. Results
+  of evaluators with larger IDs go to a heap-allocated overflow vector.
 */
 class EvaluatorCache {
-    EvaluationResults eval_results;
+    static const int INLINE_CAPACITY = 16;
+
+    struct Entry {
+        Evaluator *evaluator = nullptr;
+        EvaluationResult result;
+    };
+
+    std::array<Entry, INLINE_CAPACITY> inline_entries;
+    std::vector<Entry> overflow_entries;
+
+    Entry &get_overflow_entry(int id);
 
 public:
-    EvaluationResult &operator[](Evaluator *eval);
+    EvaluationResult &operator[](Evaluator *eval) {
+        int id = eval->get_id();
+        assert(id >= 0);
+        Entry &entry = (id < INLINE_CAPACITY) ?
+            inline_entries[id] : get_overflow_entry(id);
+        assert(!entry.evaluator || entry.evaluator == eval);
+        entry.evaluator = eval;
+        return entry.result;
+    }
 
     template<class Callback>
     void for_each_evaluator_result(const Callback &callback) const {
-        for (const auto &element : eval_results) {
-            const Evaluator *eval = element.first;
-            const EvaluationResult &result = element.second;
-            callback(eval, result);
+        for (const Entry &entry : inline_entries) {
+            if (entry.evaluator) {
+                callback(entry.evaluator, entry.result);
+            }
+        }
+        for (const Entry &entry : overflow_entries) {
+            if (entry.evaluator) {
+                callback(entry.evaluator, entry.result);
+            }
         }
     }
 };
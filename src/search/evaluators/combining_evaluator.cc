@@ -45,6 +45,13 @@ EvaluationResult CombiningEvaluator::compute_result(
     return result;
 }
 
+void CombiningEvaluator::compute_results(
+    const vector<EvaluationContext *> &eval_contexts) {
+    for (const shared_ptr<Evaluator> &subevaluator : subevaluators)
+        subevaluator->compute_results(eval_contexts);
+    Evaluator::compute_results(eval_contexts);
+}
+
 void CombiningEvaluator::get_path_dependent_evaluators(
     set<Evaluator *> &evals) {
     for (auto &subevaluator : subevaluators)
@@ -40,6 +40,12 @@ EvaluationResult WeightedEvaluator::compute_result(
     return result;
 }
 
+void WeightedEvaluator::compute_results(
+    const vector<EvaluationContext *> &eval_contexts) {
+    evaluator->compute_results(eval_contexts);
+    Evaluator::compute_results(eval_contexts);
+}
+
 void WeightedEvaluator::get_path_dependent_evaluators(set<Evaluator *> &evals) {
     evaluator->get_path_dependent_evaluators(evals);
 }
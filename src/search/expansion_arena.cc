@@ -0,0 +1,54 @@
+#include "expansion_arena.h"
+
+#include "evaluation_context.h"
+
+#include "utils/logging.h"
+
+using namespace std;
+
+ExpansionArena::ExpansionArena(int num_operators)
+    : preferred_flags(num_operators, false),
+      num_resets(0),
+      num_allocations(0),
+      applicable_ops_capacity(0),
+      preferred_ops_capacity(0) {
+}
+
+void ExpansionArena::count_allocations() {
+    if (applicable_ops.capacity() != applicable_ops_capacity) {
+        applicable_ops_capacity = applicable_ops.capacity();
+        ++num_allocations;
+    }
+    if (preferred_ops.capacity() != preferred_ops_capacity) {
+        preferred_ops_capacity = preferred_ops.capacity();
+        ++num_allocations;
+    }
+}
+
+void ExpansionArena::reset() {
+    count_allocations();
+    applicable_ops.clear();
+    for (OperatorID op_id : preferred_ops) {
+        preferred_flags[op_id.get_index()] = false;
+    }
+    preferred_ops.clear();
+    ++num_resets;
+}
+
+void ExpansionArena::collect_preferred_operators(
+    EvaluationContext &eval_context, Evaluator *preferred_operator_evaluator) {
+    if (!eval_context.is_evaluator_value_infinite(preferred_operator_evaluator)) {
+        for (OperatorID op_id : eval_context.get_preferred_operators(
+                 preferred_operator_evaluator)) {
+            if (!preferred_flags[op_id.get_index()]) {
+                preferred_flags[op_id.get_index()] = true;
+                preferred_ops.push_back(op_id);
+            }
+        }
+    }
+}
+
+void ExpansionArena::print_statistics() const {
+    utils::g_log << "Expansion arena resets: " << num_resets << endl;
+    utils::g_log << "Expansion arena allocations: " << num_allocations << endl;
+}
@@ -0,0 +1,66 @@
+#ifndef EXPANSION_ARENA_H
+#define EXPANSION_ARENA_H
+
+#include "operator_id.h"
+
+#include <vector>
+
+class EvaluationContext;
+class Evaluator;
+
+/*
+  ExpansionArena owns the temporary containers that a search engine needs
+  while expanding a single state: the applicable operators and the set of
+  preferred operators. Engines keep one arena and call reset() once at the
+  beginning of every expansion. Resetting keeps the allocated memory, so
+  after a short warm-up phase expanding a state does not allocate memory
+  for these containers anymore.
+
+  Preferred operators are stored as a list together with a flag per
+  operator. Resetting only clears the flags of the operators in the list,
+  so the cost of a reset is proportional to the number of preferred
+  operators of the previous expansion, not to the number of operators.
+
+  The arena counts how often one of its buffers had to grow, which should
+  happen only a logarithmic number of times over a search.
+*/
+class ExpansionArena {
+    std::vector<OperatorID> applicable_ops;
+    std::vector<OperatorID> preferred_ops;
+    std::vector<bool> preferred_flags;
+
+    int num_resets;
+    int num_allocations;
+    size_t applicable_ops_capacity;
+    size_t preferred_ops_capacity;
+
+    void count_allocations();
+public:
+    explicit ExpansionArena(int num_operators);
+
+    void reset();
+
+    std::vector<OperatorID> &get_applicable_ops() {
+        return applicable_ops;
+    }
+
+    /*
+      Add the preferred operators of the given evaluator to the arena, unless
+      the evaluator considers the state a dead end. Evaluating the evaluator
+      is cached by the evaluation context.
+    */
+    void collect_preferred_operators(
+        EvaluationContext &eval_context, Evaluator *preferred_operator_evaluator);
+
+    bool is_preferred(OperatorID op_id) const {
+        return preferred_flags[op_id.get_index()];
+    }
+
+    int get_num_allocations() const {
+        return num_allocations;
+    }
+
+    void print_statistics() const;
+};
+
+#endif
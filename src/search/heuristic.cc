@@ -8,6 +8,8 @@
 #include "task_utils/task_properties.h"
 #include "tasks/cost_adapted_task.h"
 #include "tasks/root_task.h"
+#include "utils/system.h"
+#include "utils/thread_pool.h"
 
 #include <cassert>
 #include <cstdlib>
@@ -95,6 +97,63 @@ EvaluationResult Heuristic::compute_result(EvaluationContext &eval_context) {
     return result;
 }
 
+bool Heuristic::prepare_parallel_evaluation(int) {
+    return false;
+}
+
+int Heuristic::compute_heuristic_in_worker(const State &, int) {
+    ABORT("Heuristic does not support parallel evaluation.");
+}
+
+void Heuristic::compute_results(
+    const vector<EvaluationContext *> &eval_contexts) {
+    utils::ThreadPool *thread_pool = utils::get_thread_pool();
+    if (thread_pool && eval_contexts.size() > 1 &&
+        prepare_parallel_evaluation(thread_pool->get_num_threads())) {
+        /*
+          The heuristic cache must not be accessed concurrently, so we
+          look up and store the cached values before and after the
+          parallel part.
+        */
+        vector<EvaluationContext *> uncached_contexts;
+        for (EvaluationContext *eval_context : eval_contexts) {
+            const State &state = eval_context->get_state();
+            if (!eval_context->has_result(this) &&
+                !eval_context->get_calculate_preferred() &&
+                !(cache_evaluator_values &&
+                  heuristic_cache[state].h != NO_VALUE &&
+                  !heuristic_cache[state].dirty)) {
+                uncached_contexts.push_back(eval_context);
+            }
+        }
+
+        vector<int> values(uncached_contexts.size());
+        thread_pool->run(
+            uncached_contexts.size(),
+            [&](int index, int worker) {
+                values[index] = compute_heuristic_in_worker(
+                    uncached_contexts[index]->get_state(), worker);
+            });
+
+        for (size_t i = 0; i < uncached_contexts.size(); ++i) {
+            EvaluationContext *eval_context = uncached_contexts[i];
+            int heuristic = values[i];
+            assert(heuristic == DEAD_END || heuristic >= 0);
+            if (cache_evaluator_values) {
+                heuristic_cache[eval_context->get_state()] =
+                    HEntry(heuristic, false);
+            }
+            EvaluationResult result;
+            result.set_count_evaluation(true);
+            result.set_evaluator_value(
+                heuristic == DEAD_END ? EvaluationResult::INFTY : heuristic);
+            eval_context->set_result(this, move(result));
+        }
+    }
+    // Evaluate the remaining contexts, e.g., those with cached values.
+    Evaluator::compute_results(eval_contexts);
+}
+
 bool Heuristic::does_cache_estimates() const {
     return cache_evaluator_values;
 }
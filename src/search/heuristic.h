@@ -63,6 +63,21 @@ protected:
 
     virtual int compute_heuristic(const State &ancestor_state) = 0;
 
+    /*
+      Heuristics that can be computed for several states at the same time
+      (see compute_results) override the following two methods.
+
+      prepare_parallel_evaluation is called before each parallel batch. It
+      should make sure that there is scratch data for the given number of
+      workers and return true. compute_heuristic_in_worker must then
+      compute the same value as compute_heuristic, but may only modify the
+      scratch data of the given worker. It is only used for evaluations
+      that do not need preferred operators.
+    */
+    virtual bool prepare_parallel_evaluation(int num_workers);
+    virtual int compute_heuristic_in_worker(
+        const State &ancestor_state, int worker);
+
     /*
       Usage note: Marking the same operator as preferred multiple times
       is OK -- it will only appear once in the list of preferred
@@ -84,6 +99,13 @@ public:
 
     virtual EvaluationResult compute_result(
         EvaluationContext &eval_context) override;
+    /*
+      If the planner uses more than one thread (see utils::ThreadPool) and
+      the heuristic supports it, all uncached values of the batch are
+      computed in parallel.
+    */
+    virtual void compute_results(
+        const std::vector<EvaluationContext *> &eval_contexts) override;
 
     virtual bool does_cache_estimates() const override;
     virtual bool is_estimate_cached(const State &state) const override;
@@ -86,6 +86,52 @@ void AdditiveHeuristic::relaxed_exploration() {
     }
 }
 
+void AdditiveHeuristic::setup_incremental_exploration_queue() {
+    queue.clear();
+
+    for (PropID prop_id : added_propositions)
+        queue.push(0, prop_id);
+
+    for (PropID prop_id : affected_propositions) {
+        for (OpID op_id : get_achievers(prop_id)) {
+            int cost = compute_operator_cost(op_id);
+            if (cost != -1)
+                enqueue_if_necessary(prop_id, cost, op_id);
+        }
+    }
+}
+
+int AdditiveHeuristic::compute_operator_cost(OpID op_id) {
+    int cost = unary_operators[op_id].base_cost;
+    for (PropID precond : get_preconditions(op_id)) {
+        int precond_cost = propositions[precond].cost;
+        if (precond_cost == -1)
+            return -1;
+        increase_cost(cost, precond_cost);
+    }
+    return cost;
+}
+
+void AdditiveHeuristic::incremental_relaxed_exploration() {
+    while (!queue.empty()) {
+        pair<int, PropID> top_pair = queue.pop();
+        int distance = top_pair.first;
+        PropID prop_id = top_pair.second;
+        Proposition *prop = get_proposition(prop_id);
+        int prop_cost = prop->cost;
+        assert(prop_cost >= 0);
+        assert(prop_cost <= distance);
+        if (prop_cost < distance)
+            continue;
+        for (OpID op_id : precondition_of_pool.get_slice(
+                 prop->precondition_of, prop->num_precondition_occurences)) {
+            int cost = compute_operator_cost(op_id);
+            if (cost != -1)
+                enqueue_if_necessary(unary_operators[op_id].effect, cost, op_id);
+        }
+    }
+}
+
 void AdditiveHeuristic::mark_preferred_operators(
     const State &state, PropID goal_id) {
     Proposition *goal = get_proposition(goal_id);
@@ -113,9 +159,18 @@ void AdditiveHeuristic::mark_preferred_operators(
 }
 
 int AdditiveHeuristic::compute_add_and_ff(const State &state) {
-    setup_exploration_queue();
-    setup_exploration_queue_state(state);
-    relaxed_exploration();
+    if (!incremental) {
+        setup_exploration_queue();
+        setup_exploration_queue_state(state);
+        relaxed_exploration();
+    } else if (prepare_incremental_exploration(state)) {
+        setup_incremental_exploration_queue();
+        incremental_relaxed_exploration();
+    } else {
+        setup_exploration_queue();
+        setup_exploration_queue_state(state);
+        incremental_relaxed_exploration();
+    }
 
     int total_cost = 0;
     for (PropID goal_id : goal_propositions) {
@@ -156,7 +211,7 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
     parser.document_property("safe", "yes for tasks without axioms");
     parser.document_property("preferred operators", "yes");
 
-    Heuristic::add_options_to_parser(parser);
+    relaxation_heuristic::RelaxationHeuristic::add_options_to_parser(parser);
     Options opts = parser.parse();
     if (parser.dry_run())
         return nullptr;
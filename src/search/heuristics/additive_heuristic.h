@@ -35,6 +35,8 @@ class AdditiveHeuristic : public relaxation_heuristic::RelaxationHeuristic {
     void setup_exploration_queue();
     void setup_exploration_queue_state(const State &state);
     void relaxed_exploration();
+    void setup_incremental_exploration_queue();
+    void incremental_relaxed_exploration();
     void mark_preferred_operators(const State &state, PropID goal_id);
 
     void enqueue_if_necessary(PropID prop_id, int cost, OpID op_id) {
@@ -58,6 +60,9 @@ class AdditiveHeuristic : public relaxation_heuristic::RelaxationHeuristic {
         }
     }
 
+    // Return -1 if some precondition of the operator is unreached.
+    int compute_operator_cost(OpID op_id);
+
     void write_overflow_warning();
 protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
@@ -6,23 +6,33 @@
 #include "../task_utils/task_properties.h"
 #include "../utils/logging.h"
 
+#include <algorithm>
 #include <cassert>
+#include <iterator>
 #include <limits>
-#include <set>
+#include <map>
 
 using namespace std;
 
 namespace hm_heuristic {
+static const int INF = numeric_limits<int>::max();
+// Markers in required_values.
+static const int UNCONSTRAINED = -1;
+static const int BLOCKED = -2;
+
 HMHeuristic::HMHeuristic(const Options &opts)
     : Heuristic(opts),
       m(opts.get<int>("m")),
       has_cond_effects(task_properties::has_conditional_effects(task_proxy)),
-      goals(task_properties::get_fact_pairs(task_proxy.get_goals())) {
+      tuple_index(task_proxy, m) {
     utils::g_log << "Using h^" << m << "." << endl;
-    utils::g_log << "The implementation of the h^m heuristic is preliminary." << endl
-                 << "It is SLOOOOOOOOOOOW." << endl
-                 << "Please do not use this for comparison!" << endl;
-    generate_all_tuples();
+    for (VariableProxy var : task_proxy.get_variables())
+        domain_sizes.push_back(var.get_domain_size());
+    goals = get_fact_ids(task_properties::get_fact_pairs(task_proxy.get_goals()));
+    build_operators();
+    hm_table.resize(tuple_index.get_num_ranks());
+    required_values.resize(domain_sizes.size(), UNCONSTRAINED);
+    utils::g_log << "Size of h^" << m << " table: " << hm_table.size() << endl;
 }
 
 
@@ -31,30 +41,114 @@ bool HMHeuristic::dead_ends_are_reliable() const {
 }
 
 
+vector<int> HMHeuristic::get_fact_ids(const vector<FactPair> &facts) const {
+    vector<int> fact_ids;
+    fact_ids.reserve(facts.size());
+    for (const FactPair &fact : facts)
+        fact_ids.push_back(tuple_index.get_fact_id(fact));
+    sort(fact_ids.begin(), fact_ids.end());
+    fact_ids.erase(unique(fact_ids.begin(), fact_ids.end()), fact_ids.end());
+    return fact_ids;
+}
+
+
+void HMHeuristic::generate_consistent_subsets(
+    const vector<int> &facts, vector<int> &subset, int index,
+    vector<vector<int>> &subsets) const {
+    for (size_t i = index; i < facts.size(); ++i) {
+        int var = tuple_index.get_fact(facts[i]).var;
+        if (!subset.empty() && tuple_index.get_fact(subset.back()).var == var)
+            continue;
+        subset.push_back(facts[i]);
+        subsets.push_back(subset);
+        if (static_cast<int>(subset.size()) < m)
+            generate_consistent_subsets(facts, subset, i + 1, subsets);
+        subset.pop_back();
+    }
+}
+
+
+void HMHeuristic::build_operators() {
+    OperatorsProxy ops = task_proxy.get_operators();
+    operators.resize(ops.size());
+    vector<int> subset;
+    vector<vector<int>> subsets;
+    for (OperatorProxy op : ops) {
+        HMOperator &hm_op = operators[op.get_id()];
+        hm_op.preconditions = get_fact_ids(
+            task_properties::get_fact_pairs(op.get_preconditions()));
+        subsets.clear();
+        generate_consistent_subsets(hm_op.preconditions, subset, 0, subsets);
+        for (const vector<int> &pre_subset : subsets)
+            hm_op.precondition_ranks.push_back(tuple_index.get_rank(pre_subset));
+
+        vector<FactPair> effect_facts;
+        for (EffectProxy eff : op.get_effects())
+            effect_facts.push_back(eff.get_fact().get_pair());
+        subsets.clear();
+        generate_consistent_subsets(get_fact_ids(effect_facts), subset, 0, subsets);
+        for (vector<int> &eff_subset : subsets) {
+            hm_op.effect_ranks.push_back(tuple_index.get_rank(eff_subset));
+            if (static_cast<int>(eff_subset.size()) < m)
+                hm_op.extendable_effects.push_back(move(eff_subset));
+        }
+
+        /*
+          A fact can extend an effect tuple if it does not contradict any
+          precondition or effect of the operator. Variables whose
+          precondition and effects disagree cannot be used at all.
+        */
+        map<int, int> required;
+        for (int fact_id : hm_op.preconditions) {
+            const FactPair &fact = tuple_index.get_fact(fact_id);
+            required[fact.var] = fact.value;
+        }
+        for (const FactPair &fact : effect_facts) {
+            auto it = required.insert(make_pair(fact.var, fact.value)).first;
+            if (it->second != fact.value)
+                it->second = BLOCKED;
+        }
+        for (const pair<const int, int> &entry : required)
+            hm_op.constrained_variables.emplace_back(entry.first, entry.second);
+    }
+}
+
+
 int HMHeuristic::compute_heuristic(const State &ancestor_state) {
     State state = convert_ancestor_state(ancestor_state);
     if (task_properties::is_goal_state(task_proxy, state)) {
         return 0;
     } else {
-        Tuple s_tup = task_properties::get_fact_pairs(state);
-
-        init_hm_table(s_tup);
+        init_hm_table(state);
         update_hm_table();
 
         int h = eval(goals);
 
-        if (h == numeric_limits<int>::max())
+        if (h == INF)
             return DEAD_END;
         return h;
     }
 }
 
 
-void HMHeuristic::init_hm_table(const Tuple &t) {
-    for (auto &hm_ent : hm_table) {
-        const Tuple &tuple = hm_ent.first;
-        int h_val = check_tuple_in_tuple(tuple, t);
-        hm_table[tuple] = h_val;
+void HMHeuristic::init_hm_table(const State &state) {
+    fill(hm_table.begin(), hm_table.end(), INF);
+    vector<int> state_facts;
+    state_facts.reserve(state.size());
+    for (FactProxy fact : state)
+        state_facts.push_back(tuple_index.get_fact_id(fact.get_pair()));
+    mark_reached_subsets(state_facts, 0, 1, 0);
+}
+
+
+void HMHeuristic::mark_reached_subsets(
+    const vector<int> &facts, int index, int size, int partial_rank) {
+    int first_rank = tuple_index.get_first_rank(size);
+    for (size_t i = index; i < facts.size(); ++i) {
+        int rank = partial_rank + tuple_index.get_rank_summand(facts[i], size);
+        hm_table[first_rank + rank] = 0;
+        if (size < m)
+            mark_reached_subsets(facts, i + 1, size + 1, rank);
     }
 }
 
@@ -66,197 +160,107 @@ void HMHeuristic::update_hm_table() {
         was_updated = false;
 
         for (OperatorProxy op : task_proxy.get_operators()) {
-            Tuple pre = get_operator_pre(op);
-
-            int c1 = eval(pre);
-            if (c1 != numeric_limits<int>::max()) {
-                Tuple eff = get_operator_eff(op);
-                vector<Tuple> partial_effs;
-                generate_all_partial_tuples(eff, partial_effs);
-                for (Tuple &partial_eff : partial_effs) {
-                    update_hm_entry(partial_eff, c1 + op.get_cost());
-
-                    int eff_size = partial_eff.size();
-                    if (eff_size < m) {
-                        extend_tuple(partial_eff, op);
-                    }
-                }
-            }
-        }
-    } while (was_updated);
-}
-
-
-void HMHeuristic::extend_tuple(const Tuple &t, const OperatorProxy &op) {
-    for (auto &hm_ent : hm_table) {
-        const Tuple &tuple = hm_ent.first;
-        bool contradict = false;
-        for (const FactPair &fact : tuple) {
-            if (contradict_effect_of(op, fact.var, fact.value)) {
-                contradict = true;
-                break;
+            const HMOperator &hm_op = operators[op.get_id()];
+            int c1 = 0;
+            for (int rank : hm_op.precondition_ranks) {
+                c1 = max(c1, hm_table[rank]);
             }
-        }
-        if (!contradict && (tuple.size() > t.size()) && (check_tuple_in_tuple(t, tuple) == 0)) {
-            Tuple pre = get_operator_pre(op);
-
-            Tuple others;
-            for (const FactPair &fact : tuple) {
-                if (find(t.begin(), t.end(), fact) == t.end()) {
-                    others.push_back(fact);
-                    if (find(pre.begin(), pre.end(), fact) == pre.end()) {
-                        pre.push_back(fact);
-                    }
+            if (c1 != INF) {
+                int op_cost = op.get_cost();
+                for (int rank : hm_op.effect_ranks) {
+                    update_hm_entry(rank, c1 + op_cost);
                 }
-            }
-
-            sort(pre.begin(), pre.end());
-
-            set<int> vars;
-            bool is_valid = true;
-            for (const FactPair &fact : pre) {
-                if (vars.count(fact.var) != 0) {
-                    is_valid = false;
-                    break;
-                }
-                vars.insert(fact.var);
-            }
-
-            if (is_valid) {
-                int c2 = eval(pre);
-                if (c2 != numeric_limits<int>::max()) {
-                    update_hm_entry(tuple, c2 + op.get_cost());
+                if (hm_op.extendable_effects.empty())
+                    continue;
+
+                for (const vector<int> &partial_eff : hm_op.extendable_effects) {
+                    for (const FactPair &constraint : hm_op.constrained_variables)
+                        required_values[constraint.var] = constraint.value;
+                    /*
+                      The extended tuple must not contain a second fact of
+                      a variable in partial_eff.
+                    */
+                    for (int fact_id : partial_eff)
+                        required_values[tuple_index.get_fact(fact_id).var] = BLOCKED;
+                    extend_tuple(partial_eff, hm_op, op_cost, 0);
                 }
+                for (const FactPair &constraint : hm_op.constrained_variables)
+                    required_values[constraint.var] = UNCONSTRAINED;
             }
         }
-    }
-}
-
-
-int HMHeuristic::eval(const Tuple &t) const {
-    vector<Tuple> partial;
-    generate_all_partial_tuples(t, partial);
-    int max = 0;
-    for (Tuple &tuple : partial) {
-        assert(hm_table.count(tuple) == 1);
-
-        int h = hm_table.at(tuple);
-        if (h > max) {
-            max = h;
-        }
-    }
-    return max;
-}
-
-
-int HMHeuristic::update_hm_entry(const Tuple &t, int val) {
-    assert(hm_table.count(t) == 1);
-    if (hm_table[t] > val) {
-        hm_table[t] = val;
-        was_updated = true;
-    }
-    return val;
+    } while (was_updated);
 }
 
 
-int HMHeuristic::check_tuple_in_tuple(
-    const Tuple &tuple, const Tuple &big_tuple) const {
-    for (const FactPair &fact0 : tuple) {
-        bool found = false;
-        for (auto &fact1 : big_tuple) {
-            if (fact0 == fact1) {
-                found = true;
-                break;
+/*
+  Update the entries of all tuples t \cup extension, where extension is a
+  nonempty set of facts over variables from first_var onwards that is
+  compatible with the operator. Such a tuple can be reached with the
+  operator from any state satisfying the preconditions and the extension.
+*/
+void HMHeuristic::extend_tuple(
+    const vector<int> &t, const HMOperator &op, int op_cost, int first_var) {
+    int num_variables = domain_sizes.size();
+    for (int var = first_var; var < num_variables; ++var) {
+        int required_value = required_values[var];
+        if (required_value == BLOCKED)
+            continue;
+        int min_value = 0;
+        int max_value = domain_sizes[var] - 1;
+        if (required_value != UNCONSTRAINED)
+            min_value = max_value = required_value;
+        for (int value = min_value; value <= max_value; ++value) {
+            extension.push_back(tuple_index.get_fact_id(FactPair(var, value)));
+
+            extended_preconditions.clear();
+            set_union(op.preconditions.begin(), op.preconditions.end(),
+                      extension.begin(), extension.end(),
+                      back_inserter(extended_preconditions));
+            int c2 = eval(extended_preconditions);
+            if (c2 != INF) {
+                extended_tuple.clear();
+                merge(t.begin(), t.end(), extension.begin(), extension.end(),
+                      back_inserter(extended_tuple));
+                update_hm_entry(tuple_index.get_rank(extended_tuple),
+                                c2 + op_cost);
             }
-        }
-        if (!found) {
-            return numeric_limits<int>::max();
-        }
-    }
-    return 0;
-}
-
-
-HMHeuristic::Tuple HMHeuristic::get_operator_pre(const OperatorProxy &op) const {
-    Tuple preconditions = task_properties::get_fact_pairs(op.get_preconditions());
-    sort(preconditions.begin(), preconditions.end());
-    return preconditions;
-}
 
-
-HMHeuristic::Tuple HMHeuristic::get_operator_eff(const OperatorProxy &op) const {
-    Tuple effects;
-    for (EffectProxy eff : op.get_effects()) {
-        effects.push_back(eff.get_fact().get_pair());
-    }
-    sort(effects.begin(), effects.end());
-    return effects;
-}
-
-
-bool HMHeuristic::contradict_effect_of(
-    const OperatorProxy &op, int var, int val) const {
-    for (EffectProxy eff : op.get_effects()) {
-        FactProxy fact = eff.get_fact();
-        if (fact.get_variable().get_id() == var && fact.get_value() != val) {
-            return true;
+            if (static_cast<int>(t.size() + extension.size()) < m)
+                extend_tuple(t, op, op_cost, var + 1);
+            extension.pop_back();
         }
     }
-    return false;
 }
 
 
-void HMHeuristic::generate_all_tuples() {
-    Tuple t;
-    generate_all_tuples_aux(0, m, t);
+int HMHeuristic::eval(const vector<int> &t) const {
+    return eval_subsets(t, 0, 1, 0);
 }
 
 
-void HMHeuristic::generate_all_tuples_aux(int var, int sz, const Tuple &base) {
-    int num_variables = task_proxy.get_variables().size();
-    for (int i = var; i < num_variables; ++i) {
-        int domain_size = task_proxy.get_variables()[i].get_domain_size();
-        for (int j = 0; j < domain_size; ++j) {
-            Tuple tuple(base);
-            tuple.emplace_back(i, j);
-            hm_table[tuple] = 0;
-            if (sz > 1) {
-                generate_all_tuples_aux(i + 1, sz - 1, tuple);
-            }
+int HMHeuristic::eval_subsets(
+    const vector<int> &t, int index, int size, int partial_rank) const {
+    int first_rank = tuple_index.get_first_rank(size);
+    int max_h = 0;
+    for (size_t i = index; i < t.size(); ++i) {
+        int rank = partial_rank + tuple_index.get_rank_summand(t[i], size);
+        int h = hm_table[first_rank + rank];
+        if (size < m && h != INF)
+            h = max(h, eval_subsets(t, i + 1, size + 1, rank));
+        if (h == INF)
+            return INF;
+        if (h > max_h) {
+            max_h = h;
         }
     }
+    return max_h;
 }
 
 
-void HMHeuristic::generate_all_partial_tuples(
-    const Tuple &base_tuple, vector<Tuple> &res) const {
-    Tuple t;
-    generate_all_partial_tuples_aux(base_tuple, t, 0, m, res);
-}
-
-
-void HMHeuristic::generate_all_partial_tuples_aux(
-    const Tuple &base_tuple, const Tuple &t, int index, int sz, vector<Tuple> &res) const {
-    if (sz == 1) {
-        for (size_t i = index; i < base_tuple.size(); ++i) {
-            Tuple tuple(t);
-            tuple.push_back(base_tuple[i]);
-            res.push_back(tuple);
-        }
-    } else {
-        for (size_t i = index; i < base_tuple.size(); ++i) {
-            Tuple tuple(t);
-            tuple.push_back(base_tuple[i]);
-            res.push_back(tuple);
-            generate_all_partial_tuples_aux(base_tuple, tuple, i + 1, sz - 1, res);
-        }
-    }
-}
-
-
-void HMHeuristic::dump_table() const {
-    for (auto &hm_ent : hm_table) {
-        utils::g_log << "h(" << hm_ent.first << ") = " << hm_ent.second << endl;
+void HMHeuristic::update_hm_entry(int rank, int val) {
+    if (hm_table[rank] > val) {
+        hm_table[rank] = val;
+        was_updated = true;
     }
 }
 
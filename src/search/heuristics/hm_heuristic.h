@@ -3,10 +3,8 @@
 
 #include "../heuristic.h"
 
-#include <algorithm>
-#include <iostream>
-#include <map>
-#include <string>
+#include "../task_utils/fact_tuple_index.h"
+
 #include <vector>
 
 namespace options {
@@ -17,45 +15,64 @@ namespace hm_heuristic {
 /*
   Haslum's h^m heuristic family ("critical path heuristics").
 
-  This is a very slow implementation and should not be used for
-  speed benchmarks.
+  Tuples are sets of at most m facts over distinct variables, represented
+  as sorted vectors of fact IDs. The h^m table stores one value per tuple
+  rank of a FactTupleIndex. The ranks of all subsets of operator
+  preconditions and effects are computed once, so the fixpoint iteration
+  only has to enumerate the extensions of effect tuples by facts that the
+  operator leaves untouched.
 */
 
+struct HMOperator {
+    // Sorted fact IDs.
+    std::vector<int> preconditions;
+    // Ranks of all nonempty subsets of the preconditions.
+    std::vector<int> precondition_ranks;
+    // Ranks of all nonempty consistent subsets of the effects.
+    std::vector<int> effect_ranks;
+    // The consistent subsets of the effects with fewer than m facts.
+    std::vector<std::vector<int>> extendable_effects;
+    // Variables without a precondition or effect are unconstrained.
+    std::vector<FactPair> constrained_variables;
+};
+
 class HMHeuristic : public Heuristic {
-    using Tuple = std::vector<FactPair>;
     // parameters
     const int m;
     const bool has_cond_effects;
 
-    const Tuple goals;
+    const fact_tuple_index::FactTupleIndex tuple_index;
+    std::vector<int> domain_sizes;
+    std::vector<int> goals;
+    std::vector<HMOperator> operators;
 
-    // h^m table
-    std::map<Tuple, int> hm_table;
+    // h^m table, indexed by tuple rank
+    std::vector<int> hm_table;
     bool was_updated;
 
+    // Scratch data for extending effect tuples.
+    std::vector<int> required_values;
+    std::vector<int> extension;
+    std::vector<int> extended_tuple;
+    std::vector<int> extended_preconditions;
+
     // auxiliary methods
-    void init_hm_table(const Tuple &t);
+    std::vector<int> get_fact_ids(const std::vector<FactPair> &facts) const;
+    void generate_consistent_subsets(
+        const std::vector<int> &facts, std::vector<int> &subset,
+        int index, std::vector<std::vector<int>> &subsets) const;
+    void build_operators();
+
+    void init_hm_table(const State &state);
+    void mark_reached_subsets(const std::vector<int> &facts, int index,
+                              int size, int partial_rank);
     void update_hm_table();
-    int eval(const Tuple &t) const;
-    int update_hm_entry(const Tuple &t, int val);
-    void extend_tuple(const Tuple &t, const OperatorProxy &op);
-
-    int check_tuple_in_tuple(const Tuple &tuple, const Tuple &big_tuple) const;
-
-    int get_operator_pre_value(const OperatorProxy &op, int var) const;
-    Tuple get_operator_pre(const OperatorProxy &op) const;
-    Tuple get_operator_eff(const OperatorProxy &op) const;
-    bool contradict_effect_of(const OperatorProxy &op, int var, int val) const;
-
-    void generate_all_tuples();
-    void generate_all_tuples_aux(int var, int sz, const Tuple &base);
-
-    void generate_all_partial_tuples(const Tuple &base_tuple,
-                                     std::vector<Tuple> &res) const;
-    void generate_all_partial_tuples_aux(const Tuple &base_tuple, const Tuple &t, int index,
-                                         int sz, std::vector<Tuple> &res) const;
-
-    void dump_table() const;
+    int eval(const std::vector<int> &t) const;
+    int eval_subsets(const std::vector<int> &t, int index, int size,
+                     int partial_rank) const;
+    void update_hm_entry(int rank, int val);
+    void extend_tuple(const std::vector<int> &t, const HMOperator &op,
+                      int op_cost, int first_var);
 
 protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
@@ -10,6 +10,7 @@
 #include "../utils/logging.h"
 #include "../utils/memory.h"
 
+#include <algorithm>
 #include <iostream>
 
 using namespace std;
@@ -17,17 +18,34 @@ using namespace std;
 namespace lm_cut_heuristic {
 LandmarkCutHeuristic::LandmarkCutHeuristic(const Options &opts)
     : Heuristic(opts),
-      landmark_generator(utils::make_unique_ptr<LandmarkCutLandmarks>(task_proxy)) {
+      landmark_generator(utils::make_unique_ptr<LandmarkCutLandmarks>(task_proxy)),
+      estimated_costs_task(
+          dynamic_cast<extra_tasks::EstimatedOperatorCostsTask *>(task.get())),
+      incremental(opts.get<bool>("incremental")),
+      parent_landmarks(nullptr),
+      pending_state_id(StateID::no_state),
+      pending_op_id(OperatorID::no_operator) {
     utils::g_log << "Initializing landmark cut heuristic..." << endl;
+    if (estimated_costs_task)
+        estimated_costs_task->subscribe(this);
 }
 
 LandmarkCutHeuristic::~LandmarkCutHeuristic() {
+    if (estimated_costs_task)
+        estimated_costs_task->unsubscribe(this);
 }
 
-int LandmarkCutHeuristic::compute_heuristic(const State &ancestor_state) {
+void LandmarkCutHeuristic::notify_operator_cost_raised(int op_id, int cost) {
+    landmark_generator->set_operator_cost(op_id, cost);
+    for (const unique_ptr<LandmarkCutLandmarks> &generator : worker_generators)
+        generator->set_operator_cost(op_id, cost);
+}
+
+int LandmarkCutHeuristic::compute_heuristic(
+    const State &ancestor_state, LandmarkCutLandmarks &generator) {
     State state = convert_ancestor_state(ancestor_state);
     int total_cost = 0;
-    bool dead_end = landmark_generator->compute_landmarks(
+    bool dead_end = generator.compute_landmarks(
         state,
         [&total_cost](int cut_cost) {total_cost += cut_cost;},
         nullptr);
@@ -37,6 +55,93 @@ int LandmarkCutHeuristic::compute_heuristic(const State &ancestor_state) {
     return total_cost;
 }
 
+int LandmarkCutHeuristic::compute_incremental_heuristic(
+    const State &ancestor_state) {
+    State state = convert_ancestor_state(ancestor_state);
+    int total_cost = 0;
+    inherited_landmarks.clear();
+    if (ancestor_state.get_id() == pending_state_id) {
+        const vector<int> &landmarks = *parent_landmarks;
+        for (size_t pos = 0; pos < landmarks.size();) {
+            int cost = landmarks[pos];
+            int size = landmarks[pos + 1];
+            auto first = landmarks.begin() + pos;
+            auto last = first + 2 + size;
+            if (find(first + 2, last, pending_op_id.get_index()) == last) {
+                inherited_landmarks.insert(
+                    inherited_landmarks.end(), first, last);
+                total_cost += cost;
+            }
+            pos += 2 + size;
+        }
+    }
+    pending_state_id = StateID::no_state;
+
+    vector<int> &landmarks = landmarks_by_state[ancestor_state];
+    landmarks = inherited_landmarks;
+    bool dead_end = landmark_generator->compute_landmarks(
+        state,
+        nullptr,
+        [&](const LandmarkCutLandmarks::Landmark &landmark, int cut_cost) {
+            total_cost += cut_cost;
+            landmarks.push_back(cut_cost);
+            landmarks.push_back(landmark.size());
+            landmarks.insert(landmarks.end(), landmark.begin(), landmark.end());
+        },
+        &inherited_landmarks);
+    if (dead_end) {
+        vector<int>().swap(landmarks);
+        return DEAD_END;
+    }
+    landmarks.shrink_to_fit();
+    return total_cost;
+}
+
+int LandmarkCutHeuristic::compute_heuristic(const State &ancestor_state) {
+    if (incremental)
+        return compute_incremental_heuristic(ancestor_state);
+    return compute_heuristic(ancestor_state, *landmark_generator);
+}
+
+void LandmarkCutHeuristic::get_path_dependent_evaluators(
+    set<Evaluator *> &evals) {
+    if (incremental)
+        evals.insert(this);
+}
+
+void LandmarkCutHeuristic::notify_state_transition(
+    const State &parent_state, OperatorID op_id, const State &state) {
+    vector<int> *landmarks = &landmarks_by_state[parent_state];
+    if (landmarks != parent_landmarks) {
+        /*
+          The search has moved on to another state, so we assume that
+          all successors of the previous one have been evaluated.
+        */
+        if (parent_landmarks)
+            vector<int>().swap(*parent_landmarks);
+        parent_landmarks = landmarks;
+    }
+    pending_state_id = state.get_id();
+    pending_op_id = op_id;
+}
+
+bool LandmarkCutHeuristic::prepare_parallel_evaluation(int num_workers) {
+    if (incremental)
+        return false;
+    while (static_cast<int>(worker_generators.size()) < num_workers - 1) {
+        worker_generators.push_back(
+            utils::make_unique_ptr<LandmarkCutLandmarks>(task_proxy));
+    }
+    return true;
+}
+
+int LandmarkCutHeuristic::compute_heuristic_in_worker(
+    const State &ancestor_state, int worker) {
+    if (worker == 0)
+        return compute_heuristic(ancestor_state, *landmark_generator);
+    return compute_heuristic(ancestor_state, *worker_generators[worker - 1]);
+}
+
 static shared_ptr<Heuristic> _parse(OptionParser &parser) {
     parser.document_synopsis("Landmark-cut heuristic", "");
     parser.document_language_support("action costs", "supported");
@@ -47,6 +152,15 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
     parser.document_property("safe", "yes");
     parser.document_property("preferred operators", "no");
 
+    parser.add_option<bool>(
+        "incremental",
+        "compute the landmarks of a successor state starting from the "
+        "landmarks of its parent that remain landmarks after applying the "
+        "operator. This is usually much faster than computing all "
+        "landmarks from scratch, but the heuristic values can be lower "
+        "and depend on the path by which a state is reached. Only eager "
+        "searches (e.g., astar and beauty) reuse landmarks regularly.",
+        "false");
     Heuristic::add_options_to_parser(parser);
     Options opts = parser.parse();
     if (parser.dry_run())
@@ -2,8 +2,12 @@
 #define HEURISTICS_LM_CUT_HEURISTIC_H
 
 #include "../heuristic.h"
+#include "../per_state_information.h"
+
+#include "../tasks/estimated_operator_costs_task.h"
 
 #include <memory>
+#include <vector>
 
 namespace options {
 class Options;
@@ -12,13 +16,50 @@ class Options;
 namespace lm_cut_heuristic {
 class LandmarkCutLandmarks;
 
-class LandmarkCutHeuristic : public Heuristic {
+class LandmarkCutHeuristic
+    : public Heuristic, public extra_tasks::OperatorCostsListener {
     std::unique_ptr<LandmarkCutLandmarks> landmark_generator;
+    /*
+      Additional landmark generators for parallel evaluation. Worker 0
+      uses landmark_generator, worker i > 0 uses worker_generators[i - 1].
+    */
+    std::vector<std::unique_ptr<LandmarkCutLandmarks>> worker_generators;
+    // Set if the heuristic is computed on the estimated-costs task.
+    extra_tasks::EstimatedOperatorCostsTask *estimated_costs_task;
+
+    /*
+      In incremental mode, we keep the landmarks of each evaluated state
+      (in the format of LandmarkCutLandmarks::compute_landmarks) until the
+      search generates the successors of another state. A successor
+      inherits the landmarks of its parent that do not contain the
+      operator leading to it and only computes cuts for the remaining
+      costs.
+    */
+    const bool incremental;
+    PerStateInformation<std::vector<int>> landmarks_by_state;
+    std::vector<int> *parent_landmarks;
+    StateID pending_state_id;
+    OperatorID pending_op_id;
+    std::vector<int> inherited_landmarks;
 
+    virtual void notify_operator_cost_raised(int op_id, int cost) override;
+
+    int compute_heuristic(
+        const State &ancestor_state, LandmarkCutLandmarks &generator);
+    int compute_incremental_heuristic(const State &ancestor_state);
     virtual int compute_heuristic(const State &ancestor_state) override;
+    virtual bool prepare_parallel_evaluation(int num_workers) override;
+    virtual int compute_heuristic_in_worker(
+        const State &ancestor_state, int worker) override;
 public:
     explicit LandmarkCutHeuristic(const options::Options &opts);
     virtual ~LandmarkCutHeuristic() override;
+
+    virtual void get_path_dependent_evaluators(
+        std::set<Evaluator *> &evals) override;
+    virtual void notify_state_transition(
+        const State &parent_state, OperatorID op_id,
+        const State &state) override;
 };
 }
 
@@ -9,24 +9,62 @@
 using namespace std;
 
 namespace lm_cut_heuristic {
+/*
+  Compute the transpose of the given adjacency lists, e.g., the operators
+  that have a proposition as precondition from the preconditions of the
+  operators. The entries of each transposed list are sorted by index.
+*/
+static void transpose_adjacency_lists(
+    const vector<int> &offsets, const vector<int> &entries, int num_targets,
+    vector<int> &transposed_offsets, vector<int> &transposed_entries) {
+    int num_sources = offsets.size() - 1;
+    transposed_offsets.assign(num_targets + 1, 0);
+    for (int target : entries)
+        ++transposed_offsets[target + 1];
+    for (int target = 0; target < num_targets; ++target)
+        transposed_offsets[target + 1] += transposed_offsets[target];
+    transposed_entries.resize(entries.size());
+    vector<int> next_position(
+        transposed_offsets.begin(), transposed_offsets.end() - 1);
+    for (int source = 0; source < num_sources; ++source) {
+        for (int i = offsets[source]; i < offsets[source + 1]; ++i)
+            transposed_entries[next_position[entries[i]]++] = source;
+    }
+}
+
 // construction and destruction
-LandmarkCutLandmarks::LandmarkCutLandmarks(const TaskProxy &task_proxy) {
+LandmarkCutLandmarks::LandmarkCutLandmarks(const TaskProxy &task_proxy)
+    : num_operators(task_proxy.get_operators().size()) {
     task_properties::verify_no_axioms(task_proxy);
     task_properties::verify_no_conditional_effects(task_proxy);
 
     // Build propositions.
-    num_propositions = 2; // artificial goal and artificial precondition
+    int num_facts = 0;
     VariablesProxy variables = task_proxy.get_variables();
-    propositions.resize(variables.size());
-    for (FactProxy fact : variables.get_facts()) {
-        int var_id = fact.get_variable().get_id();
-        propositions[var_id].push_back(RelaxedProposition());
-        ++num_propositions;
+    proposition_offsets.reserve(variables.size());
+    for (VariableProxy var : variables) {
+        proposition_offsets.push_back(num_facts);
+        num_facts += var.get_domain_size();
     }
+    artificial_precondition = num_facts;
+    artificial_goal = num_facts + 1;
+    num_propositions = num_facts + 2;
 
     // Build relaxed operators for operators and axioms.
-    for (OperatorProxy op : task_proxy.get_operators())
-        build_relaxed_operator(op);
+    precondition_offsets.reserve(num_operators + 2);
+    effect_offsets.reserve(num_operators + 2);
+    base_costs.reserve(num_operators + 1);
+    for (OperatorProxy op : task_proxy.get_operators()) {
+        precondition_offsets.push_back(preconditions.size());
+        effect_offsets.push_back(effects.size());
+        for (FactProxy pre : op.get_preconditions())
+            preconditions.push_back(get_proposition(pre));
+        if (op.get_preconditions().empty())
+            preconditions.push_back(artificial_precondition);
+        for (EffectProxy eff : op.get_effects())
+            effects.push_back(get_proposition(eff.get_fact()));
+        base_costs.push_back(op.get_cost());
+    }
 
     // Simplify relaxed operators.
     // simplify();
@@ -34,108 +72,81 @@ LandmarkCutLandmarks::LandmarkCutLandmarks(const TaskProxy &task_proxy) {
        but only after trying out whether and how much the change to
        unary operators hurts. */
 
-    // Build artificial goal proposition and operator.
-    vector<RelaxedProposition *> goal_op_pre, goal_op_eff;
-    for (FactProxy goal : task_proxy.get_goals()) {
-        goal_op_pre.push_back(get_proposition(goal));
-    }
-    goal_op_eff.push_back(&artificial_goal);
-    /* Use the invalid operator ID -1 so accessing
-       the artificial operator will generate an error. */
-    add_relaxed_operator(move(goal_op_pre), move(goal_op_eff), -1, 0);
+    /*
+      Build the artificial goal operator. It has index num_operators,
+      which is not a valid operator ID of the task.
+    */
+    precondition_offsets.push_back(preconditions.size());
+    effect_offsets.push_back(effects.size());
+    for (FactProxy goal : task_proxy.get_goals())
+        preconditions.push_back(get_proposition(goal));
+    if (task_proxy.get_goals().empty())
+        preconditions.push_back(artificial_precondition);
+    effects.push_back(artificial_goal);
+    base_costs.push_back(0);
+    precondition_offsets.push_back(preconditions.size());
+    effect_offsets.push_back(effects.size());
 
     // Cross-reference relaxed operators.
-    for (RelaxedOperator &op : relaxed_operators) {
-        for (RelaxedProposition *pre : op.preconditions)
-            pre->precondition_of.push_back(&op);
-        for (RelaxedProposition *eff : op.effects)
-            eff->effect_of.push_back(&op);
-    }
-}
+    transpose_adjacency_lists(
+        precondition_offsets, preconditions, num_propositions,
+        precondition_of_offsets, precondition_of);
+    transpose_adjacency_lists(
+        effect_offsets, effects, num_propositions,
+        effect_of_offsets, effect_of);
 
-LandmarkCutLandmarks::~LandmarkCutLandmarks() {
+    costs.resize(num_operators + 1);
+    unsatisfied_preconditions.resize(num_operators + 1);
+    h_max_supporters.resize(num_operators + 1);
+    h_max_supporter_costs.resize(num_operators + 1);
+    statuses.resize(num_propositions);
+    h_max_costs.resize(num_propositions);
 }
 
-void LandmarkCutLandmarks::build_relaxed_operator(const OperatorProxy &op) {
-    vector<RelaxedProposition *> precondition;
-    vector<RelaxedProposition *> effects;
-    for (FactProxy pre : op.get_preconditions()) {
-        precondition.push_back(get_proposition(pre));
-    }
-    for (EffectProxy eff : op.get_effects()) {
-        effects.push_back(get_proposition(eff.get_fact()));
-    }
-    add_relaxed_operator(
-        move(precondition), move(effects), op.get_id(), op.get_cost());
-}
-
-void LandmarkCutLandmarks::add_relaxed_operator(
-    vector<RelaxedProposition *> &&precondition,
-    vector<RelaxedProposition *> &&effects,
-    int op_id, int base_cost) {
-    RelaxedOperator relaxed_op(
-        move(precondition), move(effects), op_id, base_cost);
-    if (relaxed_op.preconditions.empty())
-        relaxed_op.preconditions.push_back(&artificial_precondition);
-    relaxed_operators.push_back(relaxed_op);
-}
-
-RelaxedProposition *LandmarkCutLandmarks::get_proposition(
-    const FactProxy &fact) {
-    int var_id = fact.get_variable().get_id();
-    int val = fact.get_value();
-    return &propositions[var_id][val];
+LandmarkCutLandmarks::~LandmarkCutLandmarks() {
 }
 
 // heuristic computation
 void LandmarkCutLandmarks::setup_exploration_queue() {
     priority_queue.clear();
 
-    for (auto &var_props : propositions) {
-        for (RelaxedProposition &prop : var_props) {
-            prop.status = UNREACHED;
-        }
-    }
+    fill(statuses.begin(), statuses.end(), UNREACHED);
 
-    artificial_goal.status = UNREACHED;
-    artificial_precondition.status = UNREACHED;
-
-    for (RelaxedOperator &op : relaxed_operators) {
-        op.unsatisfied_preconditions = op.preconditions.size();
-        op.h_max_supporter = 0;
-        op.h_max_supporter_cost = numeric_limits<int>::max();
+    for (int op = 0; op <= num_operators; ++op) {
+        unsatisfied_preconditions[op] = get_preconditions(op).size();
     }
+    fill(h_max_supporters.begin(), h_max_supporters.end(), -1);
+    fill(h_max_supporter_costs.begin(), h_max_supporter_costs.end(),
+         numeric_limits<int>::max());
 }
 
-void LandmarkCutLandmarks::setup_exploration_queue_state(const State &state) {
-    for (FactProxy init_fact : state) {
-        enqueue_if_necessary(get_proposition(init_fact), 0);
+void LandmarkCutLandmarks::setup_exploration_queue_state() {
+    for (int init_prop : state_propositions) {
+        enqueue_if_necessary(init_prop, 0);
     }
-    enqueue_if_necessary(&artificial_precondition, 0);
+    enqueue_if_necessary(artificial_precondition, 0);
 }
 
-void LandmarkCutLandmarks::first_exploration(const State &state) {
+void LandmarkCutLandmarks::first_exploration() {
     assert(priority_queue.empty());
     setup_exploration_queue();
-    setup_exploration_queue_state(state);
+    setup_exploration_queue_state();
     while (!priority_queue.empty()) {
-        pair<int, RelaxedProposition *> top_pair = priority_queue.pop();
+        pair<int, int> top_pair = priority_queue.pop();
         int popped_cost = top_pair.first;
-        RelaxedProposition *prop = top_pair.second;
-        int prop_cost = prop->h_max_cost;
+        int prop = top_pair.second;
+        int prop_cost = h_max_costs[prop];
         assert(prop_cost <= popped_cost);
         if (prop_cost < popped_cost)
             continue;
-        const vector<RelaxedOperator *> &triggered_operators =
-            prop->precondition_of;
-        for (RelaxedOperator *relaxed_op : triggered_operators) {
-            --relaxed_op->unsatisfied_preconditions;
-            assert(relaxed_op->unsatisfied_preconditions >= 0);
-            if (relaxed_op->unsatisfied_preconditions == 0) {
-                relaxed_op->h_max_supporter = prop;
-                relaxed_op->h_max_supporter_cost = prop_cost;
-                int target_cost = prop_cost + relaxed_op->cost;
-                for (RelaxedProposition *effect : relaxed_op->effects) {
+        for (int op : get_precondition_of(prop)) {
+            --unsatisfied_preconditions[op];
+            assert(unsatisfied_preconditions[op] >= 0);
+            if (unsatisfied_preconditions[op] == 0) {
+                h_max_supporters[op] = prop;
+                h_max_supporter_costs[op] = prop_cost;
+                int target_cost = prop_cost + costs[op];
+                for (int effect : get_effects(op)) {
                     enqueue_if_necessary(effect, target_cost);
                 }
             }
@@ -143,8 +154,7 @@ void LandmarkCutLandmarks::first_exploration(const State &state) {
     }
 }
 
-void LandmarkCutLandmarks::first_exploration_incremental(
-    vector<RelaxedOperator *> &cut) {
+void LandmarkCutLandmarks::first_exploration_incremental(vector<int> &cut) {
     assert(priority_queue.empty());
     /* We pretend that this queue has had as many pushes already as we
        have propositions to avoid switching from bucket-based to
@@ -152,32 +162,32 @@ void LandmarkCutLandmarks::first_exploration_incremental(
        to heap-based in problems where action costs are at most 1.
     */
     priority_queue.add_virtual_pushes(num_propositions);
-    for (RelaxedOperator *relaxed_op : cut) {
-        int cost = relaxed_op->h_max_supporter_cost + relaxed_op->cost;
-        for (RelaxedProposition *effect : relaxed_op->effects)
+    for (int op : cut) {
+        int cost = h_max_supporter_costs[op] + costs[op];
+        for (int effect : get_effects(op))
             enqueue_if_necessary(effect, cost);
     }
+    // See second_exploration.
+    const int *supporters = h_max_supporters.data();
     while (!priority_queue.empty()) {
-        pair<int, RelaxedProposition *> top_pair = priority_queue.pop();
+        pair<int, int> top_pair = priority_queue.pop();
         int popped_cost = top_pair.first;
-        RelaxedProposition *prop = top_pair.second;
-        int prop_cost = prop->h_max_cost;
+        int prop = top_pair.second;
+        int prop_cost = h_max_costs[prop];
         assert(prop_cost <= popped_cost);
         if (prop_cost < popped_cost)
             continue;
-        const vector<RelaxedOperator *> &triggered_operators =
-            prop->precondition_of;
-        for (RelaxedOperator *relaxed_op : triggered_operators) {
-            if (relaxed_op->h_max_supporter == prop) {
-                int old_supp_cost = relaxed_op->h_max_supporter_cost;
+        for (int op : get_precondition_of(prop)) {
+            if (supporters[op] == prop) {
+                int old_supp_cost = h_max_supporter_costs[op];
                 if (old_supp_cost > prop_cost) {
-                    relaxed_op->update_h_max_supporter();
-                    int new_supp_cost = relaxed_op->h_max_supporter_cost;
+                    update_h_max_supporter(op);
+                    int new_supp_cost = h_max_supporter_costs[op];
                     if (new_supp_cost != old_supp_cost) {
                         // This operator has become cheaper.
                         assert(new_supp_cost < old_supp_cost);
-                        int target_cost = new_supp_cost + relaxed_op->cost;
-                        for (RelaxedProposition *effect : relaxed_op->effects)
+                        int target_cost = new_supp_cost + costs[op];
+                        for (int effect : get_effects(op))
                             enqueue_if_necessary(effect, target_cost);
                     }
                 }
@@ -187,41 +197,43 @@ void LandmarkCutLandmarks::first_exploration_incremental(
 }
 
 void LandmarkCutLandmarks::second_exploration(
-    const State &state, vector<RelaxedProposition *> &second_exploration_queue,
-    vector<RelaxedOperator *> &cut) {
+    vector<int> &second_exploration_queue, vector<int> &cut) {
     assert(second_exploration_queue.empty());
     assert(cut.empty());
 
-    artificial_precondition.status = BEFORE_GOAL_ZONE;
-    second_exploration_queue.push_back(&artificial_precondition);
+    statuses[artificial_precondition] = BEFORE_GOAL_ZONE;
+    second_exploration_queue.push_back(artificial_precondition);
 
-    for (FactProxy init_fact : state) {
-        RelaxedProposition *init_prop = get_proposition(init_fact);
-        init_prop->status = BEFORE_GOAL_ZONE;
+    for (int init_prop : state_propositions) {
+        statuses[init_prop] = BEFORE_GOAL_ZONE;
         second_exploration_queue.push_back(init_prop);
     }
 
+    /*
+      The queue and the cut are int vectors like our adjacency lists, so
+      the compiler has to assume that pushing to them changes the lists.
+      Fetching the supporters once avoids reloading them in the inner loop.
+    */
+    const int *supporters = h_max_supporters.data();
     while (!second_exploration_queue.empty()) {
-        RelaxedProposition *prop = second_exploration_queue.back();
+        int prop = second_exploration_queue.back();
         second_exploration_queue.pop_back();
-        const vector<RelaxedOperator *> &triggered_operators =
-            prop->precondition_of;
-        for (RelaxedOperator *relaxed_op : triggered_operators) {
-            if (relaxed_op->h_max_supporter == prop) {
+        for (int op : get_precondition_of(prop)) {
+            if (supporters[op] == prop) {
                 bool reached_goal_zone = false;
-                for (RelaxedProposition *effect : relaxed_op->effects) {
-                    if (effect->status == GOAL_ZONE) {
-                        assert(relaxed_op->cost > 0);
+                for (int effect : get_effects(op)) {
+                    if (statuses[effect] == GOAL_ZONE) {
+                        assert(costs[op] > 0);
                         reached_goal_zone = true;
-                        cut.push_back(relaxed_op);
+                        cut.push_back(op);
                         break;
                     }
                 }
                 if (!reached_goal_zone) {
-                    for (RelaxedProposition *effect : relaxed_op->effects) {
-                        if (effect->status != BEFORE_GOAL_ZONE) {
-                            assert(effect->status == REACHED);
-                            effect->status = BEFORE_GOAL_ZONE;
+                    for (int effect : get_effects(op)) {
+                        if (statuses[effect] != BEFORE_GOAL_ZONE) {
+                            assert(statuses[effect] == REACHED);
+                            statuses[effect] = BEFORE_GOAL_ZONE;
                             second_exploration_queue.push_back(effect);
                         }
                     }
@@ -231,16 +243,16 @@ void LandmarkCutLandmarks::second_exploration(
     }
 }
 
-void LandmarkCutLandmarks::mark_goal_plateau(RelaxedProposition *subgoal) {
-    // NOTE: subgoal can be null if we got here via recursion through
+void LandmarkCutLandmarks::mark_goal_plateau(int subgoal) {
+    // NOTE: subgoal can be -1 if we got here via recursion through
     // a zero-cost action that is relaxed unreachable. (This can only
     // happen in domains which have zero-cost actions to start with.)
     // For example, this happens in pegsol-strips #01.
-    if (subgoal && subgoal->status != GOAL_ZONE) {
-        subgoal->status = GOAL_ZONE;
-        for (RelaxedOperator *achiever : subgoal->effect_of)
-            if (achiever->cost == 0)
-                mark_goal_plateau(achiever->h_max_supporter);
+    if (subgoal != -1 && statuses[subgoal] != GOAL_ZONE) {
+        statuses[subgoal] = GOAL_ZONE;
+        for (int achiever : get_effect_of(subgoal))
+            if (costs[achiever] == 0)
+                mark_goal_plateau(h_max_supporters[achiever]);
     }
 }
 
@@ -249,24 +261,24 @@ void LandmarkCutLandmarks::validate_h_max() const {
     // Using conditional compilation to avoid complaints about unused
     // variables when using NDEBUG. This whole code does nothing useful
     // when assertions are switched off anyway.
-    for (const RelaxedOperator &op : relaxed_operators) {
-        if (op.unsatisfied_preconditions) {
+    for (int op = 0; op <= num_operators; ++op) {
+        if (unsatisfied_preconditions[op]) {
             bool reachable = true;
-            for (RelaxedProposition *pre : op.preconditions) {
-                if (pre->status == UNREACHED) {
+            for (int pre : get_preconditions(op)) {
+                if (statuses[pre] == UNREACHED) {
                     reachable = false;
                     break;
                 }
             }
             assert(!reachable);
-            assert(!op.h_max_supporter);
+            assert(h_max_supporters[op] == -1);
         } else {
-            assert(op.h_max_supporter);
-            int h_max_cost = op.h_max_supporter_cost;
-            assert(h_max_cost == op.h_max_supporter->h_max_cost);
-            for (RelaxedProposition *pre : op.preconditions) {
-                assert(pre->status != UNREACHED);
-                assert(pre->h_max_cost <= h_max_cost);
+            assert(h_max_supporters[op] != -1);
+            int h_max_cost = h_max_supporter_costs[op];
+            assert(h_max_cost == h_max_costs[h_max_supporters[op]]);
+            for (int pre : get_preconditions(op)) {
+                assert(statuses[pre] != UNREACHED);
+                assert(h_max_costs[pre] <= h_max_cost);
             }
         }
     }
@@ -275,42 +287,57 @@ void LandmarkCutLandmarks::validate_h_max() const {
 
 bool LandmarkCutLandmarks::compute_landmarks(
     const State &state, CostCallback cost_callback,
-    LandmarkCallback landmark_callback) {
-    for (RelaxedOperator &op : relaxed_operators) {
-        op.cost = op.base_cost;
+    LandmarkCallback landmark_callback, const vector<int> *known_landmarks) {
+    copy(base_costs.begin(), base_costs.end(), costs.begin());
+    if (known_landmarks) {
+        for (size_t pos = 0; pos < known_landmarks->size();) {
+            int cost = (*known_landmarks)[pos];
+            int size = (*known_landmarks)[pos + 1];
+            pos += 2;
+            for (int i = 0; i < size; ++i) {
+                int op = (*known_landmarks)[pos + i];
+                costs[op] -= cost;
+                assert(costs[op] >= 0);
+            }
+            pos += size;
+        }
     }
     // The following three variables could be declared inside the loop
     // ("second_exploration_queue" even inside second_exploration),
     // but having them here saves reallocations and hence provides a
     // measurable speed boost.
-    vector<RelaxedOperator *> cut;
+    vector<int> cut;
     Landmark landmark;
-    vector<RelaxedProposition *> second_exploration_queue;
-    first_exploration(state);
+    vector<int> second_exploration_queue;
+    state_propositions.clear();
+    for (FactProxy fact : state)
+        state_propositions.push_back(get_proposition(fact));
+    first_exploration();
     // validate_h_max();  // too expensive to use even in regular debug mode
-    if (artificial_goal.status == UNREACHED)
+    if (statuses[artificial_goal] == UNREACHED)
         return true;
 
     int num_iterations = 0;
-    while (artificial_goal.h_max_cost != 0) {
+    while (h_max_costs[artificial_goal] != 0) {
         ++num_iterations;
-        mark_goal_plateau(&artificial_goal);
+        mark_goal_plateau(artificial_goal);
         assert(cut.empty());
-        second_exploration(state, second_exploration_queue, cut);
+        second_exploration(second_exploration_queue, cut);
         assert(!cut.empty());
         int cut_cost = numeric_limits<int>::max();
-        for (RelaxedOperator *op : cut)
-            cut_cost = min(cut_cost, op->cost);
-        for (RelaxedOperator *op : cut)
-            op->cost -= cut_cost;
+        for (int op : cut)
+            cut_cost = min(cut_cost, costs[op]);
+        for (int op : cut)
+            costs[op] -= cut_cost;
 
         if (cost_callback) {
             cost_callback(cut_cost);
         }
         if (landmark_callback) {
             landmark.clear();
-            for (RelaxedOperator *op : cut) {
-                landmark.push_back(op->original_op_id);
+            for (int op : cut) {
+                assert(op < num_operators);
+                landmark.push_back(op);
             }
             landmark_callback(landmark, cut_cost);
         }
@@ -325,14 +352,10 @@ bool LandmarkCutLandmarks::compute_landmarks(
           or something based on total_cost, so that we don't need a per-round
           reinitialization.
         */
-        for (auto &var_props : propositions) {
-            for (RelaxedProposition &prop : var_props) {
-                if (prop.status == GOAL_ZONE || prop.status == BEFORE_GOAL_ZONE)
-                    prop.status = REACHED;
-            }
+        for (PropositionStatus &status : statuses) {
+            if (status == GOAL_ZONE || status == BEFORE_GOAL_ZONE)
+                status = REACHED;
         }
-        artificial_goal.status = REACHED;
-        artificial_precondition.status = REACHED;
     }
     return false;
 }
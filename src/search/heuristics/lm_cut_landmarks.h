@@ -12,8 +12,6 @@
 
 namespace lm_cut_heuristic {
 // TODO: Fix duplication with the other relaxation heuristics.
-struct RelaxedProposition;
-
 enum PropositionStatus {
     UNREACHED = 0,
     REACHED = 1,
@@ -21,64 +19,112 @@ enum PropositionStatus {
     BEFORE_GOAL_ZONE = 3
 };
 
-struct RelaxedOperator {
-    int original_op_id;
-    std::vector<RelaxedProposition *> preconditions;
-    std::vector<RelaxedProposition *> effects;
-    int base_cost; // 0 for axioms, 1 for regular operators
-
-    int cost;
-    int unsatisfied_preconditions;
-    int h_max_supporter_cost; // h_max_cost of h_max_supporter
-    RelaxedProposition *h_max_supporter;
-    RelaxedOperator(std::vector<RelaxedProposition *> &&pre,
-                    std::vector<RelaxedProposition *> &&eff,
-                    int op_id, int base)
-        : original_op_id(op_id), preconditions(pre), effects(eff), base_cost(base) {
-    }
-
-    inline void update_h_max_supporter();
-};
-
-struct RelaxedProposition {
-    std::vector<RelaxedOperator *> precondition_of;
-    std::vector<RelaxedOperator *> effect_of;
-
-    PropositionStatus status;
-    int h_max_cost;
-};
-
+/*
+  Relaxed operators and propositions are identified by their indices.
+  Operator i < num_operators corresponds to operator i of the task, the
+  last operator is the artificial goal operator. Proposition IDs are
+  proposition_offsets[var] + value for facts, followed by the artificial
+  precondition and the artificial goal.
+
+  All adjacency lists are stored in compressed sparse row format: the
+  preconditions of operator op are
+  preconditions[precondition_offsets[op]] ...
+  preconditions[precondition_offsets[op + 1] - 1], and analogously for the
+  other lists. The per-round data is kept in one array per field, so that
+  the explorations only touch the fields they need.
+*/
 class LandmarkCutLandmarks {
-    std::vector<RelaxedOperator> relaxed_operators;
-    std::vector<std::vector<RelaxedProposition>> propositions;
-    RelaxedProposition artificial_precondition;
-    RelaxedProposition artificial_goal;
+    // The entries of one row of an adjacency list.
+    class IndexRange {
+        const int *first;
+        const int *last;
+    public:
+        IndexRange(const int *first, const int *last)
+            : first(first), last(last) {
+        }
+        const int *begin() const {
+            return first;
+        }
+        const int *end() const {
+            return last;
+        }
+        int size() const {
+            return last - first;
+        }
+    };
+
+    const int num_operators;
     int num_propositions;
-    priority_queues::AdaptiveQueue<RelaxedProposition *> priority_queue;
+    int artificial_precondition;
+    int artificial_goal;
+    std::vector<int> proposition_offsets;
+
+    std::vector<int> precondition_offsets;
+    std::vector<int> preconditions;
+    std::vector<int> effect_offsets;
+    std::vector<int> effects;
+    std::vector<int> precondition_of_offsets;
+    std::vector<int> precondition_of;
+    std::vector<int> effect_of_offsets;
+    std::vector<int> effect_of;
+
+    // Operator data.
+    std::vector<int> base_costs; // 0 for the artificial goal operator
+    std::vector<int> costs;
+    std::vector<int> unsatisfied_preconditions;
+    std::vector<int> h_max_supporters; // -1 if unreached
+    std::vector<int> h_max_supporter_costs; // h_max_cost of h_max_supporter
+
+    // Proposition data.
+    std::vector<PropositionStatus> statuses;
+    std::vector<int> h_max_costs;
+
+    // Propositions of the evaluated state, unpacked once per evaluation.
+    std::vector<int> state_propositions;
+
+    priority_queues::AdaptiveQueue<int> priority_queue;
+
+    static IndexRange get_row(
+        const std::vector<int> &offsets, const std::vector<int> &entries,
+        int index) {
+        return IndexRange(entries.data() + offsets[index],
+                          entries.data() + offsets[index + 1]);
+    }
+    IndexRange get_preconditions(int op) const {
+        return get_row(precondition_offsets, preconditions, op);
+    }
+    IndexRange get_effects(int op) const {
+        return get_row(effect_offsets, effects, op);
+    }
+    IndexRange get_precondition_of(int prop) const {
+        return get_row(precondition_of_offsets, precondition_of, prop);
+    }
+    IndexRange get_effect_of(int prop) const {
+        return get_row(effect_of_offsets, effect_of, prop);
+    }
 
-    void build_relaxed_operator(const OperatorProxy &op);
-    void add_relaxed_operator(std::vector<RelaxedProposition *> &&precondition,
-                              std::vector<RelaxedProposition *> &&effects,
-                              int op_id, int base_cost);
-    RelaxedProposition *get_proposition(const FactProxy &fact);
+    int get_proposition(const FactProxy &fact) const {
+        return proposition_offsets[fact.get_variable().get_id()] +
+               fact.get_value();
+    }
     void setup_exploration_queue();
-    void setup_exploration_queue_state(const State &state);
-    void first_exploration(const State &state);
-    void first_exploration_incremental(std::vector<RelaxedOperator *> &cut);
-    void second_exploration(const State &state,
-                            std::vector<RelaxedProposition *> &second_exploration_queue,
-                            std::vector<RelaxedOperator *> &cut);
-
-    void enqueue_if_necessary(RelaxedProposition *prop, int cost) {
+    void setup_exploration_queue_state();
+    void first_exploration();
+    void first_exploration_incremental(std::vector<int> &cut);
+    void second_exploration(std::vector<int> &second_exploration_queue,
+                            std::vector<int> &cut);
+
+    void enqueue_if_necessary(int prop, int cost) {
         assert(cost >= 0);
-        if (prop->status == UNREACHED || prop->h_max_cost > cost) {
-            prop->status = REACHED;
-            prop->h_max_cost = cost;
+        if (statuses[prop] == UNREACHED || h_max_costs[prop] > cost) {
+            statuses[prop] = REACHED;
+            h_max_costs[prop] = cost;
             priority_queue.push(cost, prop);
         }
     }
 
-    void mark_goal_plateau(RelaxedProposition *subgoal);
+    inline void update_h_max_supporter(int op);
+    void mark_goal_plateau(int subgoal);
     void validate_h_max() const;
 public:
     using Landmark = std::vector<int>;
@@ -88,6 +134,12 @@ public:
     LandmarkCutLandmarks(const TaskProxy &task_proxy);
     virtual ~LandmarkCutLandmarks();
 
+    // Change the cost used for the given operator in future computations.
+    void set_operator_cost(int op_id, int cost) {
+        assert(op_id >= 0 && op_id < num_operators);
+        base_costs[op_id] = cost;
+    }
+
     /*
       Compute LM-cut landmarks for the given state.
 
@@ -99,18 +151,29 @@ public:
       making a copy of the landmark, so cost_callback should be used if only the
       cost of the landmark is needed.
 
+      If known_landmarks is not nullptr, it contains landmarks of the state
+      whose costs form an admissible cost partitioning, e.g., the landmarks
+      of a predecessor that do not contain the operator leading to the
+      state. Each landmark is stored as its cost, its size and its operator
+      indices. The computation subtracts their costs from the operator
+      costs and only reports the additional landmarks.
+
       Returns true iff state is detected as a dead end.
     */
     bool compute_landmarks(const State &state, CostCallback cost_callback,
-                           LandmarkCallback landmark_callback);
+                           LandmarkCallback landmark_callback,
+                           const std::vector<int> *known_landmarks = nullptr);
 };
 
-inline void RelaxedOperator::update_h_max_supporter() {
-    assert(!unsatisfied_preconditions);
-    for (size_t i = 0; i < preconditions.size(); ++i)
-        if (preconditions[i]->h_max_cost > h_max_supporter->h_max_cost)
-            h_max_supporter = preconditions[i];
-    h_max_supporter_cost = h_max_supporter->h_max_cost;
+inline void LandmarkCutLandmarks::update_h_max_supporter(int op) {
+    assert(!unsatisfied_preconditions[op]);
+    int supporter = h_max_supporters[op];
+    for (int pre : get_preconditions(op)) {
+        if (h_max_costs[pre] > h_max_costs[supporter])
+            supporter = pre;
+    }
+    h_max_supporters[op] = supporter;
+    h_max_supporter_costs[op] = h_max_costs[supporter];
 }
 }
 
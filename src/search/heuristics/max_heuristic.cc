@@ -42,14 +42,14 @@ void HSPMaxHeuristic::setup_exploration_queue() {
         op.cost = op.base_cost; // will be increased by precondition costs
 
         if (op.unsatisfied_preconditions == 0)
-            enqueue_if_necessary(op.effect, op.base_cost);
+            enqueue_if_necessary(op.effect, op.base_cost, get_op_id(op));
     }
 }
 
 void HSPMaxHeuristic::setup_exploration_queue_state(const State &state) {
     for (FactProxy fact : state) {
         PropID init_prop = get_prop_id(fact);
-        enqueue_if_necessary(init_prop, 0);
+        enqueue_if_necessary(init_prop, 0, NO_OP);
     }
 }
 
@@ -75,7 +75,54 @@ void HSPMaxHeuristic::relaxed_exploration() {
             --unary_op->unsatisfied_preconditions;
             assert(unary_op->unsatisfied_preconditions >= 0);
             if (unary_op->unsatisfied_preconditions == 0)
-                enqueue_if_necessary(unary_op->effect, unary_op->cost);
+                enqueue_if_necessary(unary_op->effect, unary_op->cost, op_id);
+        }
+    }
+}
+
+void HSPMaxHeuristic::setup_incremental_exploration_queue() {
+    queue.clear();
+
+    for (PropID prop_id : added_propositions)
+        queue.push(0, prop_id);
+
+    for (PropID prop_id : affected_propositions) {
+        for (OpID op_id : get_achievers(prop_id)) {
+            int cost = compute_operator_cost(op_id);
+            if (cost != -1)
+                enqueue_if_necessary(prop_id, cost, op_id);
+        }
+    }
+}
+
+int HSPMaxHeuristic::compute_operator_cost(OpID op_id) const {
+    const UnaryOperator &unary_op = unary_operators[op_id];
+    int cost = unary_op.base_cost;
+    for (PropID precond : get_preconditions(op_id)) {
+        int precond_cost = propositions[precond].cost;
+        if (precond_cost == -1)
+            return -1;
+        cost = max(cost, unary_op.base_cost + precond_cost);
+    }
+    return cost;
+}
+
+void HSPMaxHeuristic::incremental_relaxed_exploration() {
+    while (!queue.empty()) {
+        pair<int, PropID> top_pair = queue.pop();
+        int distance = top_pair.first;
+        PropID prop_id = top_pair.second;
+        Proposition *prop = get_proposition(prop_id);
+        int prop_cost = prop->cost;
+        assert(prop_cost >= 0);
+        assert(prop_cost <= distance);
+        if (prop_cost < distance)
+            continue;
+        for (OpID op_id : precondition_of_pool.get_slice(
+                 prop->precondition_of, prop->num_precondition_occurences)) {
+            int cost = compute_operator_cost(op_id);
+            if (cost != -1)
+                enqueue_if_necessary(unary_operators[op_id].effect, cost, op_id);
         }
     }
 }
@@ -83,9 +130,18 @@ void HSPMaxHeuristic::relaxed_exploration() {
 int HSPMaxHeuristic::compute_heuristic(const State &ancestor_state) {
     State state = convert_ancestor_state(ancestor_state);
 
-    setup_exploration_queue();
-    setup_exploration_queue_state(state);
-    relaxed_exploration();
+    if (!incremental) {
+        setup_exploration_queue();
+        setup_exploration_queue_state(state);
+        relaxed_exploration();
+    } else if (prepare_incremental_exploration(state)) {
+        setup_incremental_exploration_queue();
+        incremental_relaxed_exploration();
+    } else {
+        setup_exploration_queue();
+        setup_exploration_queue_state(state);
+        incremental_relaxed_exploration();
+    }
 
     int total_cost = 0;
     for (PropID goal_id : goal_propositions) {
@@ -112,7 +168,7 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
     parser.document_property("safe", "yes for tasks without axioms");
     parser.document_property("preferred operators", "no");
 
-    Heuristic::add_options_to_parser(parser);
+    relaxation_heuristic::RelaxationHeuristic::add_options_to_parser(parser);
     Options opts = parser.parse();
     if (parser.dry_run())
         return nullptr;
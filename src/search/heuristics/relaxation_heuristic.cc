@@ -1,5 +1,7 @@
 #include "relaxation_heuristic.h"
 
+#include "../option_parser.h"
+
 #include "../task_utils/task_properties.h"
 #include "../utils/collections.h"
 #include "../utils/logging.h"
@@ -36,7 +38,10 @@ UnaryOperator::UnaryOperator(
 
 // construction and destruction
 RelaxationHeuristic::RelaxationHeuristic(const options::Options &opts)
-    : Heuristic(opts) {
+    : Heuristic(opts),
+      estimated_costs_task(
+          dynamic_cast<extra_tasks::EstimatedOperatorCostsTask *>(task.get())),
+      incremental(opts.get<bool>("incremental")) {
     // Build propositions.
     propositions.resize(task_properties::get_num_facts(task_proxy));
 
@@ -67,10 +72,21 @@ RelaxationHeuristic::RelaxationHeuristic(const options::Options &opts)
     for (OperatorProxy axiom : task_proxy.get_axioms())
         build_unary_operators(axiom);
 
-    // Simplify unary operators.
-    utils::Timer simplify_timer;
-    simplify();
-    utils::g_log << "time to simplify: " << simplify_timer << endl;
+    if (estimated_costs_task) {
+        unary_operators_by_operator.resize(task_proxy.get_operators().size());
+        int num_unary_ops = unary_operators.size();
+        for (OpID op_id = 0; op_id < num_unary_ops; ++op_id) {
+            int op_no = unary_operators[op_id].operator_no;
+            if (op_no != -1)
+                unary_operators_by_operator[op_no].push_back(op_id);
+        }
+        estimated_costs_task->subscribe(this);
+    } else {
+        // Simplify unary operators.
+        utils::Timer simplify_timer;
+        simplify();
+        utils::g_log << "time to simplify: " << simplify_timer << endl;
+    }
 
     // Cross-reference unary operators.
     vector<vector<OpID>> precondition_of_vectors(propositions.size());
@@ -88,6 +104,113 @@ RelaxationHeuristic::RelaxationHeuristic(const options::Options &opts)
             precondition_of_pool.append(precondition_of_vec);
         propositions[prop_id].num_precondition_occurences = precondition_of_vec.size();
     }
+
+    if (incremental) {
+        vector<vector<OpID>> achiever_vectors(propositions.size());
+        for (OpID op_id = 0; op_id < num_unary_ops; ++op_id)
+            achiever_vectors[unary_operators[op_id].effect].push_back(op_id);
+        achievers.reserve(num_propositions);
+        num_achievers.reserve(num_propositions);
+        for (const vector<OpID> &achiever_vec : achiever_vectors) {
+            achievers.push_back(achievers_pool.append(achiever_vec));
+            num_achievers.push_back(achiever_vec.size());
+        }
+        is_affected.resize(num_propositions, false);
+    }
+}
+
+RelaxationHeuristic::~RelaxationHeuristic() {
+    if (estimated_costs_task)
+        estimated_costs_task->unsubscribe(this);
+}
+
+void RelaxationHeuristic::notify_operator_cost_raised(int op_no, int cost) {
+    for (OpID op_id : unary_operators_by_operator[op_no])
+        unary_operators[op_id].base_cost = cost;
+    // The stored exploration is based on the old costs.
+    explored_state_values.clear();
+}
+
+void RelaxationHeuristic::add_options_to_parser(OptionParser &parser) {
+    parser.add_option<bool>(
+        "incremental",
+        "update the relaxed exploration of the previously evaluated state "
+        "instead of computing it from scratch. The heuristic values are the "
+        "same, but ties between best achievers may be broken differently.",
+        "false");
+    Heuristic::add_options_to_parser(parser);
+}
+
+void RelaxationHeuristic::unmark_propositions(PropID prop_id) {
+    Proposition *prop = get_proposition(prop_id);
+    if (prop->marked) {
+        prop->marked = false;
+        OpID op_id = prop->reached_by;
+        if (op_id != NO_OP) {
+            for (PropID precond : get_preconditions(op_id))
+                unmark_propositions(precond);
+        }
+    }
+}
+
+bool RelaxationHeuristic::prepare_incremental_exploration(const State &state) {
+    assert(incremental);
+    vector<int> state_values = state.get_unpacked_values();
+    if (explored_state_values.empty()) {
+        explored_state_values = move(state_values);
+        return false;
+    }
+
+    /*
+      The propositions marked for the previous state (e.g., for preferred
+      operators) are reachable from the goals via the best achievers, so
+      we can clear the marks before the best achievers change.
+    */
+    for (PropID goal_id : goal_propositions)
+        unmark_propositions(goal_id);
+
+    affected_propositions.clear();
+    added_propositions.clear();
+    int num_variables = state_values.size();
+    for (int var = 0; var < num_variables; ++var) {
+        int old_value = explored_state_values[var];
+        int new_value = state_values[var];
+        if (old_value != new_value) {
+            PropID removed_id = get_prop_id(var, old_value);
+            is_affected[removed_id] = true;
+            affected_propositions.push_back(removed_id);
+
+            PropID added_id = get_prop_id(var, new_value);
+            Proposition *added = get_proposition(added_id);
+            added->cost = 0;
+            added->reached_by = NO_OP;
+            added_propositions.push_back(added_id);
+        }
+    }
+
+    // Collect all propositions whose best achiever depends on affected ones.
+    for (size_t i = 0; i < affected_propositions.size(); ++i) {
+        const Proposition *prop = get_proposition(affected_propositions[i]);
+        for (OpID op_id : precondition_of_pool.get_slice(
+                 prop->precondition_of, prop->num_precondition_occurences)) {
+            PropID effect_id = unary_operators[op_id].effect;
+            if (!is_affected[effect_id] &&
+                propositions[effect_id].reached_by == op_id) {
+                is_affected[effect_id] = true;
+                affected_propositions.push_back(effect_id);
+            }
+        }
+    }
+
+    for (PropID prop_id : affected_propositions) {
+        Proposition *prop = get_proposition(prop_id);
+        prop->cost = -1;
+        prop->reached_by = NO_OP;
+        is_affected[prop_id] = false;
+    }
+
+    explored_state_values = move(state_values);
+    return true;
 }
 
 bool RelaxationHeuristic::dead_ends_are_reliable() const {
@@ -5,6 +5,7 @@
 
 #include "../heuristic.h"
 
+#include "../tasks/estimated_operator_costs_task.h"
 #include "../utils/collections.h"
 
 #include <cassert>
@@ -54,12 +55,35 @@ struct UnaryOperator {
 
 static_assert(sizeof(UnaryOperator) == 28, "UnaryOperator has wrong size");
 
-class RelaxationHeuristic : public Heuristic {
+class RelaxationHeuristic
+    : public Heuristic, public extra_tasks::OperatorCostsListener {
     void build_unary_operators(const OperatorProxy &op);
     void simplify();
 
     // proposition_offsets[var_no]: first PropID related to variable var_no
     std::vector<PropID> proposition_offsets;
+
+    /*
+      Set if the heuristic is computed on the estimated-costs task. The
+      unary operators are then not simplified because dominance depends
+      on the costs, and unary_operators_by_operator[op_no] holds the
+      unary operators created for each operator to update their costs.
+    */
+    extra_tasks::EstimatedOperatorCostsTask *estimated_costs_task;
+    std::vector<std::vector<OpID>> unary_operators_by_operator;
+
+    virtual void notify_operator_cost_raised(int op_no, int cost) override;
+
+    // Data for incremental evaluation (see prepare_incremental_exploration).
+    // State whose relaxed exploration is stored in propositions; empty if
+    // the next exploration has to start from scratch.
+    std::vector<int> explored_state_values;
+    std::vector<bool> is_affected;
+    array_pool::ArrayPool achievers_pool;
+    std::vector<array_pool::ArrayPoolIndex> achievers;
+    std::vector<int> num_achievers;
+
+    void unmark_propositions(PropID prop_id);
 protected:
     std::vector<UnaryOperator> unary_operators;
     std::vector<Proposition> propositions;
@@ -68,6 +92,40 @@ protected:
     array_pool::ArrayPool preconditions_pool;
     array_pool::ArrayPool precondition_of_pool;
 
+    /*
+      In incremental mode, the relaxed exploration of the previously
+      evaluated state is kept and only updated for the facts in which the
+      next state differs from it. Since states are usually evaluated right
+      after their siblings, the changes are typically small.
+
+      Facts that are no longer true and all propositions whose best
+      achiever (reached_by) transitively depends on them are "affected":
+      their costs may increase, so they are reset to "unreached". Facts
+      that became true get cost 0. Starting from these propositions, the
+      subclasses then rerun their exploration, which only touches
+      propositions whose costs actually change (in the spirit of the
+      DynamicSWSF-FP algorithm by Ramalingam and Reps).
+
+      In incremental mode, explorations must always run to the fixpoint
+      and set reached_by, and operator costs are recomputed from the
+      costs of their preconditions whenever they are needed.
+    */
+    const bool incremental;
+    std::vector<PropID> affected_propositions;
+    std::vector<PropID> added_propositions;
+
+    /*
+      Return false if the exploration has to start from scratch.
+      Otherwise, reset the affected propositions, set the costs of the
+      added propositions to 0 and store both in the vectors above.
+    */
+    bool prepare_incremental_exploration(const State &state);
+
+    array_pool::ArrayPoolSlice get_achievers(PropID prop_id) const {
+        return achievers_pool.get_slice(
+            achievers[prop_id], num_achievers[prop_id]);
+    }
+
     array_pool::ArrayPoolSlice get_preconditions(OpID op_id) const {
         const UnaryOperator &op = unary_operators[op_id];
         return preconditions_pool.get_slice(op.preconditions, op.num_preconditions);
@@ -111,6 +169,9 @@ protected:
     Proposition *get_proposition(const FactProxy &fact);
 public:
     explicit RelaxationHeuristic(const options::Options &options);
+    virtual ~RelaxationHeuristic() override;
+
+    static void add_options_to_parser(options::OptionParser &parser);
 
     virtual bool dead_ends_are_reliable() const override;
 };
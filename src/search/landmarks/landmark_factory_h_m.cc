@@ -9,6 +9,7 @@
 #include "../task_utils/task_properties.h"
 #include "../utils/collections.h"
 #include "../utils/logging.h"
+#include "../utils/memory.h"
 #include "../utils/system.h"
 
 using namespace std;
@@ -459,6 +460,19 @@ void LandmarkFactoryHM::build_pm_ops(const TaskProxy &task_proxy) {
     // set unsatisfied precondition counts, used in fixpoint calculation
     unsat_pc_count_.resize(operators.size());
 
+    // subsets with size *<* m, ordered by size and then lexicographically
+    vector<int> noop_sets;
+    for (size_t i = 0; i < h_m_table_.size(); ++i) {
+        if (static_cast<int>(h_m_table_[i].fluents.size()) < m_)
+            noop_sets.push_back(i);
+    }
+    FluentSetComparer comparer;
+    sort(noop_sets.begin(), noop_sets.end(),
+         [&](int index1, int index2) {
+             return comparer(h_m_table_[index1].fluents,
+                             h_m_table_[index2].fluents);
+         });
+
     VariablesProxy variables = task_proxy.get_variables();
 
     // transfer ops from original problem
@@ -479,8 +493,7 @@ void LandmarkFactoryHM::build_pm_ops(const TaskProxy &task_proxy) {
         unsat_pc_count_[op.get_id()].first = pc_subsets.size();
 
         for (const FluentSet &pc_subset : pc_subsets) {
-            assert(set_indices_.find(pc_subset) != set_indices_.end());
-            set_index = set_indices_[pc_subset];
+            set_index = get_set_index(pc_subset);
             pm_op.pc.push_back(set_index);
             h_m_table_[set_index].pc_for.emplace_back(op.get_id(), -1);
         }
@@ -491,8 +504,7 @@ void LandmarkFactoryHM::build_pm_ops(const TaskProxy &task_proxy) {
         pm_op.eff.reserve(eff_subsets.size());
 
         for (const FluentSet &eff_subset : eff_subsets) {
-            assert(set_indices_.find(eff_subset) != set_indices_.end());
-            set_index = set_indices_[eff_subset];
+            set_index = get_set_index(eff_subset);
             pm_op.eff.push_back(set_index);
         }
 
@@ -502,10 +514,9 @@ void LandmarkFactoryHM::build_pm_ops(const TaskProxy &task_proxy) {
         // they conflict with the effect of the operator (no need to check pc
         // because mvvs appearing in pc also appear in effect
 
-        FluentSetToIntMap::const_iterator it = set_indices_.begin();
-        while (static_cast<int>(it->first.size()) < m_
-               && it != set_indices_.end()) {
-            if (possible_noop_set(variables, eff, it->first)) {
+        for (int noop_set_index : noop_sets) {
+            const FluentSet &noop_set = h_m_table_[noop_set_index].fluents;
+            if (possible_noop_set(variables, eff, noop_set)) {
                 // for each such set, add a "conditional effect" to the operator
                 pm_op.cond_noops.resize(pm_op.cond_noops.size() + 1);
 
@@ -517,8 +528,8 @@ void LandmarkFactoryHM::build_pm_ops(const TaskProxy &task_proxy) {
                 // get the subsets that have >= 1 element in the pc (unless pc is empty)
                 // and >= 1 element in the other set
 
-                get_split_m_sets(variables, m_, noop_pc_subsets, pc, it->first);
-                get_split_m_sets(variables, m_, noop_eff_subsets, eff, it->first);
+                get_split_m_sets(variables, m_, noop_pc_subsets, pc, noop_set);
+                get_split_m_sets(variables, m_, noop_eff_subsets, eff, noop_set);
 
                 this_cond_noop.reserve(noop_pc_subsets.size() + noop_eff_subsets.size() + 1);
 
@@ -527,9 +538,7 @@ void LandmarkFactoryHM::build_pm_ops(const TaskProxy &task_proxy) {
                 // push back all noop preconditions
                 for (size_t j = 0; j < noop_pc_subsets.size(); ++j) {
                     assert(static_cast<int>(noop_pc_subsets[j].size()) <= m_);
-                    assert(set_indices_.find(noop_pc_subsets[j]) != set_indices_.end());
-
-                    set_index = set_indices_[noop_pc_subsets[j]];
+                    set_index = get_set_index(noop_pc_subsets[j]);
                     this_cond_noop.push_back(set_index);
                     // these facts are "conditional pcs" for this action
                     h_m_table_[set_index].pc_for.emplace_back(op.get_id(), noop_index);
@@ -541,15 +550,12 @@ void LandmarkFactoryHM::build_pm_ops(const TaskProxy &task_proxy) {
                 // and the noop effects
                 for (size_t j = 0; j < noop_eff_subsets.size(); ++j) {
                     assert(static_cast<int>(noop_eff_subsets[j].size()) <= m_);
-                    assert(set_indices_.find(noop_eff_subsets[j]) != set_indices_.end());
-
-                    set_index = set_indices_[noop_eff_subsets[j]];
+                    set_index = get_set_index(noop_eff_subsets[j]);
                     this_cond_noop.push_back(set_index);
                 }
 
                 ++noop_index;
             }
-            ++it;
         }
         //    print_pm_op(pm_ops_[i]);
     }
@@ -568,6 +574,12 @@ LandmarkFactoryHM::LandmarkFactoryHM(const options::Options &opts)
       use_orders(opts.get<bool>("use_orders")) {
 }
 
+int LandmarkFactoryHM::get_set_index(const FluentSet &fs) const {
+    int set_index = set_indices_[tuple_index_->get_rank(fs)];
+    assert(set_index != -1);
+    return set_index;
+}
+
 void LandmarkFactoryHM::initialize(const TaskProxy &task_proxy) {
     utils::g_log << "h^m landmarks m=" << m_ << endl;
     if (!task_proxy.get_axioms().empty()) {
@@ -579,9 +591,12 @@ void LandmarkFactoryHM::initialize(const TaskProxy &task_proxy) {
     get_m_sets(task_proxy.get_variables(), m_, msets);
 
     // map each set to an integer
+    tuple_index_ = utils::make_unique_ptr<fact_tuple_index::FactTupleIndex>(
+        task_proxy, m_);
+    set_indices_.assign(tuple_index_->get_num_ranks(), -1);
     for (size_t i = 0; i < msets.size(); ++i) {
         h_m_table_.emplace_back();
-        set_indices_[msets[i]] = i;
+        set_indices_[tuple_index_->get_rank(msets[i])] = i;
         h_m_table_[i].fluents = msets[i];
     }
     utils::g_log << "Using " << h_m_table_.size() << " P^m fluents." << endl;
@@ -671,7 +686,8 @@ void LandmarkFactoryHM::free_unneeded_memory() {
     utils::release_vector_memory(pm_ops_);
     utils::release_vector_memory(unsat_pc_count_);
 
-    set_indices_.clear();
+    tuple_index_ = nullptr;
+    utils::release_vector_memory(set_indices_);
     lm_node_table_.clear();
 }
 
@@ -721,7 +737,7 @@ void LandmarkFactoryHM::compute_h_m_landmarks(const TaskProxy &task_proxy) {
 
     // for all of the initial state <= m subsets, mark level = 0
     for (size_t i = 0; i < init_subsets.size(); ++i) {
-        int index = set_indices_[init_subsets[i]];
+        int index = get_set_index(init_subsets[i]);
         h_m_table_[index].level = 0;
 
         // set actions to be applied
@@ -933,9 +949,7 @@ void LandmarkFactoryHM::generate_landmarks(
     get_m_sets(variables, m_, goal_subsets, goals);
     list<int> all_lms;
     for (const FluentSet &goal_subset : goal_subsets) {
-        assert(set_indices_.find(goal_subset) != set_indices_.end());
-
-        int set_index = set_indices_[goal_subset];
+        int set_index = get_set_index(goal_subset);
 
         if (h_m_table_[set_index].level == -1) {
             utils::g_log << endl << endl << "Subset of goal not reachable !!." << endl << endl << endl;
@@ -380,11 +380,27 @@ vector<unique_ptr<TransitionSystem>> FTSFactory::create_transition_systems(const
         ts_data.label_equivalence_relation =
             utils::make_unique_ptr<LabelEquivalenceRelation>(
                 labels, ts_data.label_groups);
+        // Store the transitions of all groups consecutively.
+        size_t num_transitions = 0;
+        for (const vector<Transition> &group_transitions : ts_data.transitions_by_group_id)
+            num_transitions += group_transitions.size();
+        vector<Transition> transitions;
+        transitions.reserve(num_transitions);
+        vector<size_t> group_offsets;
+        group_offsets.reserve(ts_data.transitions_by_group_id.size() + 1);
+        group_offsets.push_back(0);
+        for (const vector<Transition> &group_transitions : ts_data.transitions_by_group_id) {
+            transitions.insert(transitions.end(),
+                               group_transitions.begin(), group_transitions.end());
+            group_offsets.push_back(transitions.size());
+        }
+        utils::release_vector_memory(ts_data.transitions_by_group_id);
         result.push_back(utils::make_unique_ptr<TransitionSystem>(
                              ts_data.num_variables,
                              move(ts_data.incorporated_variables),
                              move(ts_data.label_equivalence_relation),
-                             move(ts_data.transitions_by_group_id),
+                             move(transitions),
+                             move(group_offsets),
                              ts_data.num_states,
                              move(ts_data.goal_states),
                              ts_data.init_state
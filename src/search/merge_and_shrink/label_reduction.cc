@@ -10,18 +10,20 @@
 #include "../plugin.h"
 #include "../task_proxy.h"
 
-#include "../algorithms/equivalence_relation.h"
 #include "../utils/collections.h"
+#include "../utils/hash.h"
 #include "../utils/logging.h"
 #include "../utils/markup.h"
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
 #include "../utils/system.h"
+#include "../utils/thread_pool.h"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <string>
-#include <unordered_map>
+#include <tuple>
 
 using namespace std;
 using utils::ExitCode;
@@ -59,88 +61,192 @@ void LabelReduction::initialize(const TaskProxy &task_proxy) {
     }
 }
 
-void LabelReduction::compute_label_mapping(
-    const equivalence_relation::EquivalenceRelation *relation,
-    const FactoredTransitionSystem &fts,
-    vector<pair<int, vector<int>>> &label_mapping,
-    utils::Verbosity verbosity) const {
+/*
+  Label reduction needs to find the labels that are locally equivalent in
+  all transition systems except one. Instead of refining an equivalence
+  relation with the label groups of all other transition systems for every
+  transition system, we hash the group of every label in every transition
+  system and maintain the sum of these hashes for every label (its
+  fingerprint). Subtracting the hash for one transition system gives a
+  value that is equal for all labels that are locally equivalent in all
+  other transition systems, so candidates are found by sorting the labels
+  by this value. Since hashes may collide, the candidates are checked
+  before reducing them.
+*/
+static const int NUM_LABELS_PER_FINGERPRINT_JOB = 1024;
+
+static uint64_t compute_label_hash(int ts_index, int group_id) {
+    utils::HashState hash_state;
+    utils::feed(hash_state, ts_index);
+    utils::feed(hash_state, group_id);
+    return hash_state.get_hash64();
+}
+
+vector<uint64_t> LabelReduction::compute_label_fingerprints(
+    const FactoredTransitionSystem &fts) const {
     const Labels &labels = fts.get_labels();
-    int next_new_label_no = labels.get_size();
-    int num_labels = 0;
-    int num_labels_after_reduction = 0;
-    for (auto group_it = relation->begin();
-         group_it != relation->end(); ++group_it) {
-        const equivalence_relation::Block &block = *group_it;
-        unordered_map<int, vector<int>> equivalent_label_nos;
-        for (auto label_it = block.begin();
-             label_it != block.end(); ++label_it) {
-            assert(*label_it < next_new_label_no);
-            int label_no = *label_it;
-            if (labels.is_current_label(label_no)) {
-                // only consider non-reduced labels
-                int cost = labels.get_label_cost(label_no);
-                equivalent_label_nos[cost].push_back(label_no);
-                ++num_labels;
+    int num_labels = labels.get_size();
+    vector<int> active_indices;
+    for (int index : fts) {
+        active_indices.push_back(index);
+    }
+    vector<uint64_t> fingerprints(num_labels, 0);
+    int num_jobs = (num_labels + NUM_LABELS_PER_FINGERPRINT_JOB - 1) /
+        NUM_LABELS_PER_FINGERPRINT_JOB;
+    utils::run_in_parallel(
+        num_jobs, [&](int job, int) {
+            int begin = job * NUM_LABELS_PER_FINGERPRINT_JOB;
+            int end = min(num_labels, begin + NUM_LABELS_PER_FINGERPRINT_JOB);
+            for (int label_no = begin; label_no < end; ++label_no) {
+                if (!labels.is_current_label(label_no))
+                    continue;
+                uint64_t fingerprint = 0;
+                for (int index : active_indices) {
+                    const TransitionSystem &ts = fts.get_transition_system(index);
+                    fingerprint += compute_label_hash(
+                        index, ts.get_label_group_id(label_no));
+                }
+                fingerprints[label_no] = fingerprint;
             }
-        }
-        for (auto it = equivalent_label_nos.begin();
-             it != equivalent_label_nos.end(); ++it) {
-            const vector<int> &label_nos = it->second;
-            if (label_nos.size() > 1) {
-                if (verbosity >= utils::Verbosity::DEBUG) {
-                    utils::g_log << "Reducing labels " << label_nos << " to " << next_new_label_no << endl;
+        });
+    return fingerprints;
+}
+
+/*
+  Split the given labels into classes of labels that are locally equivalent
+  in all given transition systems. The labels are usually equivalent, so
+  we compare every label to the first label of every class found so far.
+*/
+static vector<vector<int>> compute_equivalence_classes(
+    const vector<int> &label_nos,
+    const FactoredTransitionSystem &fts,
+    const vector<int> &ts_indices) {
+    vector<vector<int>> equivalence_classes;
+    for (int label_no : label_nos) {
+        bool found_class = false;
+        for (vector<int> &equivalence_class : equivalence_classes) {
+            int other_label_no = equivalence_class.front();
+            bool equivalent = true;
+            for (int index : ts_indices) {
+                const TransitionSystem &ts = fts.get_transition_system(index);
+                if (ts.get_label_group_id(label_no) !=
+                    ts.get_label_group_id(other_label_no)) {
+                    equivalent = false;
+                    break;
                 }
-                label_mapping.push_back(make_pair(next_new_label_no, label_nos));
-                ++next_new_label_no;
             }
-            if (!label_nos.empty()) {
-                ++num_labels_after_reduction;
+            if (equivalent) {
+                equivalence_class.push_back(label_no);
+                found_class = true;
+                break;
             }
         }
+        if (!found_class) {
+            equivalence_classes.push_back({label_no});
+        }
     }
-    int number_reduced_labels = num_labels - num_labels_after_reduction;
-    if (verbosity >= utils::Verbosity::VERBOSE && number_reduced_labels > 0) {
-        utils::g_log << "Label reduction: "
-                     << num_labels << " labels, "
-                     << num_labels_after_reduction << " after reduction"
-                     << endl;
-    }
+    return equivalence_classes;
 }
 
-equivalence_relation::EquivalenceRelation
-*LabelReduction::compute_combinable_equivalence_relation(
+bool LabelReduction::reduce_combinable_labels(
     int ts_index,
-    const FactoredTransitionSystem &fts) const {
-    /*
-      Returns an equivalence relation over labels s.t. l ~ l'
-      iff l and l' are locally equivalent in all transition systems
-      T' \neq T. (They may or may not be locally equivalent in T.)
-    */
-
-    // Create the equivalence relation where all labels are equivalent.
+    FactoredTransitionSystem &fts,
+    vector<uint64_t> &fingerprints,
+    utils::Verbosity verbosity) const {
     const Labels &labels = fts.get_labels();
+    const TransitionSystem &ts = fts.get_transition_system(ts_index);
     int num_labels = labels.get_size();
-    vector<pair<int, int>> annotated_labels;
-    annotated_labels.reserve(num_labels);
+
+    /*
+      Sort all non-reduced labels by their fingerprint without the hash for
+      ts_index and by their cost. Combinable labels form consecutive runs.
+    */
+    vector<uint64_t> partial_fingerprints(num_labels, 0);
+    vector<tuple<uint64_t, int, int>> sorted_labels;
     for (int label_no = 0; label_no < num_labels; ++label_no) {
         if (labels.is_current_label(label_no)) {
-            annotated_labels.push_back(make_pair(0, label_no));
+            partial_fingerprints[label_no] = fingerprints[label_no] -
+                compute_label_hash(ts_index, ts.get_label_group_id(label_no));
+            sorted_labels.emplace_back(
+                partial_fingerprints[label_no],
+                labels.get_label_cost(label_no),
+                label_no);
         }
     }
-    equivalence_relation::EquivalenceRelation *relation =
-        equivalence_relation::EquivalenceRelation::from_annotated_elements<int>(
-            num_labels, annotated_labels);
+    sort(sorted_labels.begin(), sorted_labels.end());
 
+    vector<int> other_indices;
     for (int index : fts) {
         if (index != ts_index) {
-            const TransitionSystem &ts = fts.get_transition_system(index);
-            for (GroupAndTransitions gat : ts) {
-                const LabelGroup &label_group = gat.label_group;
-                relation->refine(label_group.begin(), label_group.end());
+            other_indices.push_back(index);
+        }
+    }
+    vector<vector<int>> reducible_label_nos;
+    int num_reduced_labels = 0;
+    vector<int> run;
+    for (size_t i = 0; i < sorted_labels.size(); ++i) {
+        run.push_back(get<2>(sorted_labels[i]));
+        if (i + 1 < sorted_labels.size() &&
+            get<0>(sorted_labels[i + 1]) == get<0>(sorted_labels[i]) &&
+            get<1>(sorted_labels[i + 1]) == get<1>(sorted_labels[i])) {
+            continue;
+        }
+        if (run.size() > 1) {
+            for (vector<int> &label_nos :
+                 compute_equivalence_classes(run, fts, other_indices)) {
+                if (label_nos.size() > 1) {
+                    num_reduced_labels += label_nos.size() - 1;
+                    reducible_label_nos.push_back(move(label_nos));
+                }
             }
         }
+        run.clear();
+    }
+    if (reducible_label_nos.empty()) {
+        return false;
+    }
+
+    // Number the new labels in the order of the smallest reduced labels.
+    sort(reducible_label_nos.begin(), reducible_label_nos.end());
+    vector<pair<int, vector<int>>> label_mapping;
+    label_mapping.reserve(reducible_label_nos.size());
+    int next_new_label_no = num_labels;
+    for (vector<int> &label_nos : reducible_label_nos) {
+        if (verbosity >= utils::Verbosity::DEBUG) {
+            utils::g_log << "Reducing labels " << label_nos << " to " << next_new_label_no << endl;
+        }
+        label_mapping.emplace_back(next_new_label_no, move(label_nos));
+        ++next_new_label_no;
+    }
+    if (verbosity >= utils::Verbosity::VERBOSE) {
+        int num_current_labels = sorted_labels.size();
+        utils::g_log << "Label reduction: "
+                     << num_current_labels << " labels, "
+                     << num_current_labels - num_reduced_labels << " after reduction"
+                     << endl;
+    }
+
+    fts.apply_label_mapping(label_mapping, ts_index);
+
+    /*
+      A new label belongs to the same groups as the labels it replaces in
+      all transition systems except the one at ts_index. The label groups
+      of the latter have changed, so we recompute its hashes.
+    */
+    num_labels = labels.get_size();
+    partial_fingerprints.resize(num_labels);
+    for (const pair<int, vector<int>> &mapping : label_mapping) {
+        partial_fingerprints[mapping.first] =
+            partial_fingerprints[mapping.second.front()];
+    }
+    fingerprints.assign(num_labels, 0);
+    for (int label_no = 0; label_no < num_labels; ++label_no) {
+        if (labels.is_current_label(label_no)) {
+            fingerprints[label_no] = partial_fingerprints[label_no] +
+                compute_label_hash(ts_index, ts.get_label_group_id(label_no));
+        }
     }
-    return relation;
+    return true;
 }
 
 bool LabelReduction::reduce(
@@ -163,28 +269,13 @@ bool LabelReduction::reduce(
         assert(fts.is_active(next_merge.first));
         assert(fts.is_active(next_merge.second));
 
-        bool reduced = false;
-        equivalence_relation::EquivalenceRelation *relation =
-            compute_combinable_equivalence_relation(next_merge.first, fts);
-        vector<pair<int, vector<int>>> label_mapping;
-        compute_label_mapping(relation, fts, label_mapping, verbosity);
-        if (!label_mapping.empty()) {
-            fts.apply_label_mapping(label_mapping, next_merge.first);
+        vector<uint64_t> fingerprints = compute_label_fingerprints(fts);
+        bool reduced = reduce_combinable_labels(
+            next_merge.first, fts, fingerprints, verbosity);
+        if (reduce_combinable_labels(
+                next_merge.second, fts, fingerprints, verbosity)) {
             reduced = true;
         }
-        delete relation;
-        relation = nullptr;
-        utils::release_vector_memory(label_mapping);
-
-        relation = compute_combinable_equivalence_relation(
-            next_merge.second,
-            fts);
-        compute_label_mapping(relation, fts, label_mapping, verbosity);
-        if (!label_mapping.empty()) {
-            fts.apply_label_mapping(label_mapping, next_merge.second);
-            reduced = true;
-        }
-        delete relation;
         return reduced;
     }
 
@@ -207,6 +298,7 @@ bool LabelReduction::reduce(
     }
 
     int num_unsuccessful_iterations = 0;
+    vector<uint64_t> fingerprints = compute_label_fingerprints(fts);
 
     bool reduced = false;
     /*
@@ -223,15 +315,10 @@ bool LabelReduction::reduce(
     for (int i = 0; i < max_iterations; ++i) {
         int ts_index = transition_system_order[tso_index];
 
-        vector<pair<int, vector<int>>> label_mapping;
-        if (fts.is_active(ts_index)) {
-            equivalence_relation::EquivalenceRelation *relation =
-                compute_combinable_equivalence_relation(ts_index, fts);
-            compute_label_mapping(relation, fts, label_mapping, verbosity);
-            delete relation;
-        }
+        bool ts_reduced = fts.is_active(ts_index) &&
+            reduce_combinable_labels(ts_index, fts, fingerprints, verbosity);
 
-        if (label_mapping.empty()) {
+        if (!ts_reduced) {
             /*
               Even if the index is inactive, we need to count it as
               unsuccessful iterations, because the number of indices, i.e.
@@ -243,7 +330,6 @@ bool LabelReduction::reduce(
             reduced = true;
             // See comment for the loop and its exit conditions.
             num_unsuccessful_iterations = 1;
-            fts.apply_label_mapping(label_mapping, ts_index);
         }
         if (num_unsuccessful_iterations == num_transition_systems) {
             // See comment for the loop and its exit conditions.
@@ -1,15 +1,12 @@
 #ifndef MERGE_AND_SHRINK_LABEL_REDUCTION_H
 #define MERGE_AND_SHRINK_LABEL_REDUCTION_H
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 
 class TaskProxy;
 
-namespace equivalence_relation {
-class EquivalenceRelation;
-}
-
 namespace options {
 class Options;
 }
@@ -63,17 +60,23 @@ class LabelReduction {
     std::shared_ptr<utils::RandomNumberGenerator> rng;
 
     bool initialized() const;
-    /* Apply the given label equivalence relation to the set of labels and
-       compute the resulting label mapping. */
-    void compute_label_mapping(
-        const equivalence_relation::EquivalenceRelation *relation,
-        const FactoredTransitionSystem &fts,
-        std::vector<std::pair<int, std::vector<int>>> &label_mapping,
-        utils::Verbosity verbosity) const;
-    equivalence_relation::EquivalenceRelation
-    *compute_combinable_equivalence_relation(
-        int ts_index,
+    /*
+      Return the fingerprints of all labels: the fingerprint of a label is
+      the sum of the hashes of its label groups in all active transition
+      systems (see label_reduction.cc).
+    */
+    std::vector<uint64_t> compute_label_fingerprints(
         const FactoredTransitionSystem &fts) const;
+    /*
+      Reduce all labels with the same cost that are locally equivalent in
+      all transition systems except the one at ts_index, and update the
+      fingerprints accordingly. Return true iff labels have been reduced.
+    */
+    bool reduce_combinable_labels(
+        int ts_index,
+        FactoredTransitionSystem &fts,
+        std::vector<uint64_t> &fingerprints,
+        utils::Verbosity verbosity) const;
 public:
     explicit LabelReduction(const options::Options &options);
     void initialize(const TaskProxy &task_proxy);
@@ -7,16 +7,20 @@
 #include "transition_system.h"
 #include "types.h"
 
+#include "../disk_cache.h"
 #include "../option_parser.h"
 #include "../plugin.h"
 
 #include "../task_utils/task_properties.h"
 
+#include "../utils/hash.h"
 #include "../utils/logging.h"
+#include "../utils/mapped_file.h"
 #include "../utils/markup.h"
 #include "../utils/system.h"
 
 #include <cassert>
+#include <cstring>
 #include <iostream>
 #include <utility>
 
@@ -24,13 +28,38 @@ using namespace std;
 using utils::ExitCode;
 
 namespace merge_and_shrink {
+/*
+  Layout of merge-and-shrink cache files: the magic bytes, the format
+  version, a byte-order mark, the cache key, the number of representations
+  and four bytes of padding, followed by the representations (see
+  MergeAndShrinkRepresentation::write).
+*/
+static const char CACHE_MAGIC[8] = {'\x89', 'F', 'D', 'M', 'A', 'S', '\n', '\0'};
+static const uint32_t CACHE_FORMAT_VERSION = 1;
+static const uint32_t CACHE_BYTE_ORDER_MARK = 0x01020304;
+static const size_t CACHE_HEADER_SIZE = 32;
+
 MergeAndShrinkHeuristic::MergeAndShrinkHeuristic(const options::Options &opts)
     : Heuristic(opts),
       verbosity(opts.get<utils::Verbosity>("verbosity")) {
     utils::g_log << "Initializing merge-and-shrink heuristic..." << endl;
-    MergeAndShrinkAlgorithm algorithm(opts);
-    FactoredTransitionSystem fts = algorithm.build_factored_transition_system(task_proxy);
-    extract_factors(fts);
+    uint64_t cache_key = 0;
+    string cache_file;
+    if (disk_cache::cache_is_enabled()) {
+        cache_key = compute_cache_key(opts.get_unparsed_config());
+        cache_file = disk_cache::get_cache_file("mas", cache_key);
+    }
+    if (!cache_file.empty() && load_from_cache_file(cache_file, cache_key)) {
+        utils::g_log << "Loaded " << mas_representations.size()
+                     << " merge-and-shrink representation(s) from "
+                     << cache_file << endl;
+    } else {
+        MergeAndShrinkAlgorithm algorithm(opts);
+        FactoredTransitionSystem fts = algorithm.build_factored_transition_system(task_proxy);
+        extract_factors(fts);
+        if (!cache_file.empty())
+            write_to_cache_file(cache_file, cache_key);
+    }
     utils::g_log << "Done initializing merge-and-shrink heuristic." << endl << endl;
 }
 
@@ -113,6 +142,106 @@ void MergeAndShrinkHeuristic::extract_factors(FactoredTransitionSystem &fts) {
     }
 }
 
+uint64_t MergeAndShrinkHeuristic::compute_cache_key(const string &config) const {
+    /*
+      The representations depend on the whole task (including the initial
+      state if unreachable states are pruned) and on all options. Since all
+      variable values are nonnegative, -1 separates the lists.
+    */
+    utils::HashState hash_state;
+    utils::feed(hash_state, CACHE_FORMAT_VERSION);
+    utils::feed(hash_state, static_cast<uint64_t>(config.size()));
+    for (char c : config) {
+        utils::feed(hash_state, static_cast<int>(c));
+    }
+    for (VariableProxy var : task_proxy.get_variables()) {
+        utils::feed(hash_state, var.get_domain_size());
+    }
+    utils::feed(hash_state, -1);
+    utils::feed(hash_state, static_cast<int>(task_proxy.get_axioms().size()));
+    for (OperatorProxy op : task_proxy.get_operators()) {
+        utils::feed(hash_state, -1);
+        utils::feed(hash_state, op.get_cost());
+        for (FactProxy pre : op.get_preconditions()) {
+            utils::feed(hash_state, pre.get_pair());
+        }
+        for (EffectProxy eff : op.get_effects()) {
+            utils::feed(hash_state, -1);
+            for (FactProxy cond : eff.get_conditions()) {
+                utils::feed(hash_state, cond.get_pair());
+            }
+            utils::feed(hash_state, -1);
+            utils::feed(hash_state, eff.get_fact().get_pair());
+        }
+    }
+    utils::feed(hash_state, -1);
+    for (FactProxy goal : task_proxy.get_goals()) {
+        utils::feed(hash_state, goal.get_pair());
+    }
+    utils::feed(hash_state, -1);
+    utils::feed(hash_state, task_proxy.get_initial_state());
+    return hash_state.get_hash64();
+}
+
+template<typename T>
+static T read_header_field(const char *header, size_t &pos) {
+    T value;
+    memcpy(&value, header + pos, sizeof(T));
+    pos += sizeof(T);
+    return value;
+}
+
+bool MergeAndShrinkHeuristic::load_from_cache_file(
+    const string &file_name, uint64_t key) {
+    shared_ptr<utils::MappedFile> file = make_shared<utils::MappedFile>(file_name);
+    if (!file->is_open() || file->get_size() < CACHE_HEADER_SIZE)
+        return false;
+    const char *header = file->get_data();
+    if (memcmp(header, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0)
+        return false;
+    size_t pos = sizeof(CACHE_MAGIC);
+    uint32_t version = read_header_field<uint32_t>(header, pos);
+    uint32_t byte_order_mark = read_header_field<uint32_t>(header, pos);
+    uint64_t file_key = read_header_field<uint64_t>(header, pos);
+    int32_t num_representations = read_header_field<int32_t>(header, pos);
+    pos += sizeof(int32_t);
+    assert(pos == CACHE_HEADER_SIZE);
+    if (version != CACHE_FORMAT_VERSION ||
+        byte_order_mark != CACHE_BYTE_ORDER_MARK ||
+        file_key != key || num_representations < 0) {
+        return false;
+    }
+    vector<unique_ptr<MergeAndShrinkRepresentation>> representations;
+    representations.reserve(num_representations);
+    for (int i = 0; i < num_representations; ++i) {
+        unique_ptr<MergeAndShrinkRepresentation> representation =
+            MergeAndShrinkRepresentation::read(file, pos, task_proxy);
+        if (!representation)
+            return false;
+        representations.push_back(move(representation));
+    }
+    if (pos != file->get_size())
+        return false;
+    assert(mas_representations.empty());
+    mas_representations = move(representations);
+    return true;
+}
+
+void MergeAndShrinkHeuristic::write_to_cache_file(
+    const string &file_name, uint64_t key) const {
+    disk_cache::CacheWriter writer(file_name);
+    writer.write_array(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    writer.write<uint32_t>(CACHE_FORMAT_VERSION);
+    writer.write<uint32_t>(CACHE_BYTE_ORDER_MARK);
+    writer.write<uint64_t>(key);
+    writer.write<int32_t>(mas_representations.size());
+    writer.write<int32_t>(0);
+    for (const unique_ptr<MergeAndShrinkRepresentation> &mas_representation : mas_representations) {
+        mas_representation->write(writer);
+    }
+    writer.commit();
+}
+
 int MergeAndShrinkHeuristic::compute_heuristic(const State &ancestor_state) {
     State state = convert_ancestor_state(ancestor_state);
     int heuristic = 0;
@@ -219,6 +348,12 @@ static shared_ptr<Heuristic> _parse(options::OptionParser &parser) {
         "score_based_filtering(scoring_functions=[goal_relevance,dfp,"
         "total_order])),label_reduction=exact(before_shrinking=true,"
         "before_merging=false),max_states=50k,threshold_before_merge=1)\n}}}\n");
+    parser.document_note(
+        "Note",
+        "If a cache directory is set with the command-line option "
+        "--cache-dir, the final merge-and-shrink representations are "
+        "stored there and reused in later runs with the same task and "
+        "the same options.");
 
     Heuristic::add_options_to_parser(parser);
     add_merge_and_shrink_algorithm_options_to_parser(parser);
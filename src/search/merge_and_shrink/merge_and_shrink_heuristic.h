@@ -3,7 +3,10 @@
 
 #include "../heuristic.h"
 
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace utils {
 enum class Verbosity;
@@ -23,6 +26,18 @@ class MergeAndShrinkHeuristic : public Heuristic {
     bool extract_unsolvable_factor(FactoredTransitionSystem &fts);
     void extract_nontrivial_factors(FactoredTransitionSystem &fts);
     void extract_factors(FactoredTransitionSystem &fts);
+
+    /*
+      Hash of the task and the configuration of the heuristic. It
+      identifies the representations in the disk cache.
+    */
+    uint64_t compute_cache_key(const std::string &config) const;
+    /*
+      Try to map the representations from the given cache file. Returns
+      false if the file does not exist or does not match the task.
+    */
+    bool load_from_cache_file(const std::string &file_name, uint64_t key);
+    void write_to_cache_file(const std::string &file_name, uint64_t key) const;
 protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
 public:
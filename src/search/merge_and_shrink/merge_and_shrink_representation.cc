@@ -3,18 +3,126 @@
 #include "distances.h"
 #include "types.h"
 
+#include "../disk_cache.h"
 #include "../task_proxy.h"
 
 #include "../utils/logging.h"
+#include "../utils/mapped_file.h"
+#include "../utils/memory.h"
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <iostream>
 #include <numeric>
 
 using namespace std;
 
 namespace merge_and_shrink {
+/*
+  Representations are stored in pre-order. Every node starts with its type
+  and its domain size, followed by the variable and the number of entries
+  (leaves) or the dimensions of the lookup table (merges), and the entries
+  of the table. All fields are 32-bit integers, so the entries can
+  be used directly from the memory-mapped file if the node starts at an
+  offset that is a multiple of 4.
+*/
+static_assert(sizeof(int) == sizeof(int32_t), "lookup table entries must have 32 bits");
+static const int32_t LEAF_NODE = 0;
+static const int32_t MERGE_NODE = 1;
+
+LookupTable::LookupTable(size_t num_entries)
+    : owned_entries(num_entries),
+      entries(owned_entries.data()),
+      num_entries(num_entries) {
+}
+
+LookupTable::LookupTable(
+    shared_ptr<utils::MappedFile> file, const int *entries, size_t num_entries)
+    : file(move(file)),
+      entries(entries),
+      num_entries(num_entries) {
+}
+
+/*
+  Read the given number of 32-bit integers at pos and advance pos. Returns
+  nullptr if the file is too short.
+*/
+static const int32_t *read_fields(
+    const utils::MappedFile &file, size_t &pos, size_t num_fields) {
+    assert(pos % sizeof(int32_t) == 0);
+    if (num_fields > (file.get_size() - pos) / sizeof(int32_t))
+        return nullptr;
+    const int32_t *fields = reinterpret_cast<const int32_t *>(file.get_data() + pos);
+    pos += num_fields * sizeof(int32_t);
+    return fields;
+}
+
+/*
+  Check that the lookup table of a node below the root only contains
+  abstract states of the node, because the parent uses them as indices.
+*/
+static bool has_valid_states(const LookupTable &lookup_table, int domain_size) {
+    for (int entry : lookup_table) {
+        if (entry != PRUNED_STATE && (entry < 0 || entry >= domain_size))
+            return false;
+    }
+    return true;
+}
+
+unique_ptr<MergeAndShrinkRepresentation> MergeAndShrinkRepresentation::read(
+    const shared_ptr<utils::MappedFile> &file, size_t &pos,
+    const TaskProxy &task_proxy, bool is_root) {
+    const int32_t *header = read_fields(*file, pos, 4);
+    if (!header)
+        return nullptr;
+    int32_t type = header[0];
+    int32_t domain_size = header[1];
+    if (domain_size < 0)
+        return nullptr;
+
+    if (type == LEAF_NODE) {
+        int32_t var_id = header[2];
+        int32_t num_entries = header[3];
+        VariablesProxy variables = task_proxy.get_variables();
+        if (var_id < 0 || var_id >= static_cast<int>(variables.size()) ||
+            num_entries != variables[var_id].get_domain_size())
+            return nullptr;
+        const int32_t *entries = read_fields(*file, pos, num_entries);
+        if (!entries)
+            return nullptr;
+        LookupTable lookup_table(file, entries, num_entries);
+        if (!is_root && !has_valid_states(lookup_table, domain_size))
+            return nullptr;
+        return utils::make_unique_ptr<MergeAndShrinkRepresentationLeaf>(
+            var_id, domain_size, move(lookup_table));
+    } else if (type == MERGE_NODE) {
+        int32_t num_rows = header[2];
+        int32_t num_columns = header[3];
+        if (num_rows < 0 || num_columns < 0)
+            return nullptr;
+        size_t num_entries = static_cast<size_t>(num_rows) * num_columns;
+        const int32_t *entries = read_fields(*file, pos, num_entries);
+        if (!entries)
+            return nullptr;
+        LookupTable lookup_table(file, entries, num_entries);
+        if (!is_root && !has_valid_states(lookup_table, domain_size))
+            return nullptr;
+        unique_ptr<MergeAndShrinkRepresentation> left_child =
+            read(file, pos, task_proxy, false);
+        if (!left_child || left_child->get_domain_size() != num_rows)
+            return nullptr;
+        unique_ptr<MergeAndShrinkRepresentation> right_child =
+            read(file, pos, task_proxy, false);
+        if (!right_child || right_child->get_domain_size() != num_columns)
+            return nullptr;
+        return utils::make_unique_ptr<MergeAndShrinkRepresentationMerge>(
+            move(left_child), move(right_child), domain_size, move(lookup_table));
+    }
+    return nullptr;
+}
+
+
 MergeAndShrinkRepresentation::MergeAndShrinkRepresentation(int domain_size)
     : domain_size(domain_size) {
 }
@@ -35,6 +143,13 @@ MergeAndShrinkRepresentationLeaf::MergeAndShrinkRepresentationLeaf(
     iota(lookup_table.begin(), lookup_table.end(), 0);
 }
 
+MergeAndShrinkRepresentationLeaf::MergeAndShrinkRepresentationLeaf(
+    int var_id, int domain_size, LookupTable &&lookup_table)
+    : MergeAndShrinkRepresentation(domain_size),
+      var_id(var_id),
+      lookup_table(move(lookup_table)) {
+}
+
 void MergeAndShrinkRepresentationLeaf::set_distances(
     const Distances &distances) {
     assert(distances.are_goal_distances_computed());
@@ -79,6 +194,14 @@ void MergeAndShrinkRepresentationLeaf::dump() const {
     utils::g_log << endl;
 }
 
+void MergeAndShrinkRepresentationLeaf::write(disk_cache::CacheWriter &writer) const {
+    writer.write<int32_t>(LEAF_NODE);
+    writer.write<int32_t>(domain_size);
+    writer.write<int32_t>(var_id);
+    writer.write<int32_t>(lookup_table.size());
+    writer.write_array(lookup_table.begin(), lookup_table.size());
+}
+
 
 MergeAndShrinkRepresentationMerge::MergeAndShrinkRepresentationMerge(
     unique_ptr<MergeAndShrinkRepresentation> left_child_,
@@ -87,25 +210,31 @@ MergeAndShrinkRepresentationMerge::MergeAndShrinkRepresentationMerge(
                                    right_child_->get_domain_size()),
       left_child(move(left_child_)),
       right_child(move(right_child_)),
-      lookup_table(left_child->get_domain_size(),
-                   vector<int>(right_child->get_domain_size())) {
-    int counter = 0;
-    for (vector<int> &row : lookup_table) {
-        for (int &entry : row) {
-            entry = counter;
-            ++counter;
-        }
-    }
+      right_domain_size(right_child->get_domain_size()),
+      lookup_table(static_cast<size_t>(left_child->get_domain_size()) *
+                   right_domain_size) {
+    iota(lookup_table.begin(), lookup_table.end(), 0);
+}
+
+MergeAndShrinkRepresentationMerge::MergeAndShrinkRepresentationMerge(
+    unique_ptr<MergeAndShrinkRepresentation> left_child_,
+    unique_ptr<MergeAndShrinkRepresentation> right_child_,
+    int domain_size, LookupTable &&lookup_table)
+    : MergeAndShrinkRepresentation(domain_size),
+      left_child(move(left_child_)),
+      right_child(move(right_child_)),
+      right_domain_size(right_child->get_domain_size()),
+      lookup_table(move(lookup_table)) {
+    assert(this->lookup_table.size() ==
+           static_cast<size_t>(left_child->get_domain_size()) * right_domain_size);
 }
 
 void MergeAndShrinkRepresentationMerge::set_distances(
     const Distances &distances) {
     assert(distances.are_goal_distances_computed());
-    for (vector<int> &row : lookup_table) {
-        for (int &entry : row) {
-            if (entry != PRUNED_STATE) {
-                entry = distances.get_goal_distance(entry);
-            }
+    for (int &entry : lookup_table) {
+        if (entry != PRUNED_STATE) {
+            entry = distances.get_goal_distance(entry);
         }
     }
 }
@@ -113,12 +242,10 @@ void MergeAndShrinkRepresentationMerge::set_distances(
 void MergeAndShrinkRepresentationMerge::apply_abstraction_to_lookup_table(
     const vector<int> &abstraction_mapping) {
     int new_domain_size = 0;
-    for (vector<int> &row : lookup_table) {
-        for (int &entry : row) {
-            if (entry != PRUNED_STATE) {
-                entry = abstraction_mapping[entry];
-                new_domain_size = max(new_domain_size, entry + 1);
-            }
+    for (int &entry : lookup_table) {
+        if (entry != PRUNED_STATE) {
+            entry = abstraction_mapping[entry];
+            new_domain_size = max(new_domain_size, entry + 1);
         }
     }
     domain_size = new_domain_size;
@@ -130,15 +257,13 @@ int MergeAndShrinkRepresentationMerge::get_value(
     int state2 = right_child->get_value(state);
     if (state1 == PRUNED_STATE || state2 == PRUNED_STATE)
         return PRUNED_STATE;
-    return lookup_table[state1][state2];
+    return lookup_table[static_cast<size_t>(state1) * right_domain_size + state2];
 }
 
 bool MergeAndShrinkRepresentationMerge::is_total() const {
-    for (const vector<int> &row : lookup_table) {
-        for (int entry : row) {
-            if (entry == PRUNED_STATE) {
-                return false;
-            }
+    for (int entry : lookup_table) {
+        if (entry == PRUNED_STATE) {
+            return false;
         }
     }
     return left_child->is_total() && right_child->is_total();
@@ -146,15 +271,24 @@ bool MergeAndShrinkRepresentationMerge::is_total() const {
 
 void MergeAndShrinkRepresentationMerge::dump() const {
     utils::g_log << "lookup table (merge): " << endl;
-    for (const auto &row : lookup_table) {
-        for (const auto &value : row) {
-            utils::g_log << value << ", ";
-        }
-        utils::g_log << endl;
+    for (size_t i = 0; i < lookup_table.size(); ++i) {
+        utils::g_log << lookup_table[i] << ", ";
+        if ((i + 1) % right_domain_size == 0)
+            utils::g_log << endl;
     }
     utils::g_log << "left child:" << endl;
     left_child->dump();
     utils::g_log << "right child:" << endl;
     right_child->dump();
 }
+
+void MergeAndShrinkRepresentationMerge::write(disk_cache::CacheWriter &writer) const {
+    writer.write<int32_t>(MERGE_NODE);
+    writer.write<int32_t>(domain_size);
+    writer.write<int32_t>(left_child->get_domain_size());
+    writer.write<int32_t>(right_domain_size);
+    writer.write_array(lookup_table.begin(), lookup_table.size());
+    left_child->write(writer);
+    right_child->write(writer);
+}
 }
@@ -1,13 +1,71 @@
 #ifndef MERGE_AND_SHRINK_MERGE_AND_SHRINK_REPRESENTATION_H
 #define MERGE_AND_SHRINK_MERGE_AND_SHRINK_REPRESENTATION_H
 
+#include <cassert>
+#include <cstddef>
 #include <memory>
 #include <vector>
 
 class State;
+class TaskProxy;
+
+namespace disk_cache {
+class CacheWriter;
+}
+
+namespace utils {
+class MappedFile;
+}
 
 namespace merge_and_shrink {
 class Distances;
+
+/*
+  Entries of the lookup table of a merge-and-shrink representation. The
+  entries are owned by the table while the representation is computed. A
+  representation loaded from the disk cache uses the entries directly from
+  the memory-mapped cache file; such tables cannot be modified.
+*/
+class LookupTable {
+    std::vector<int> owned_entries;
+    std::shared_ptr<utils::MappedFile> file;
+    const int *entries;
+    std::size_t num_entries;
+public:
+    explicit LookupTable(std::size_t num_entries);
+    LookupTable(std::shared_ptr<utils::MappedFile> file,
+                const int *entries, std::size_t num_entries);
+    // Moving keeps the buffer of owned_entries, and hence entries, valid.
+    LookupTable(LookupTable &&other) = default;
+
+    int operator[](std::size_t index) const {
+        assert(index < num_entries);
+        return entries[index];
+    }
+
+    int *begin() {
+        assert(!file);
+        return owned_entries.data();
+    }
+
+    int *end() {
+        assert(!file);
+        return owned_entries.data() + num_entries;
+    }
+
+    const int *begin() const {
+        return entries;
+    }
+
+    const int *end() const {
+        return entries + num_entries;
+    }
+
+    std::size_t size() const {
+        return num_entries;
+    }
+};
+
 class MergeAndShrinkRepresentation {
 protected:
     int domain_size;
@@ -33,15 +91,31 @@ public:
        to PRUNED_STATE. */
     virtual bool is_total() const = 0;
     virtual void dump() const = 0;
+
+    // Append the representation to a merge-and-shrink cache file.
+    virtual void write(disk_cache::CacheWriter &writer) const = 0;
+    /*
+      Read a representation written with write() from the given file,
+      starting at byte offset pos, and advance pos past it. The lookup tables
+      of the result use the file directly. Returns nullptr if the data is
+      not a valid representation for the given task. The entries of the
+      root are distances and are not checked because they are never used
+      as indices.
+    */
+    static std::unique_ptr<MergeAndShrinkRepresentation> read(
+        const std::shared_ptr<utils::MappedFile> &file, std::size_t &pos,
+        const TaskProxy &task_proxy, bool is_root = true);
 };
 
 
 class MergeAndShrinkRepresentationLeaf : public MergeAndShrinkRepresentation {
     const int var_id;
 
-    std::vector<int> lookup_table;
+    LookupTable lookup_table;
 public:
     MergeAndShrinkRepresentationLeaf(int var_id, int domain_size);
+    MergeAndShrinkRepresentationLeaf(
+        int var_id, int domain_size, LookupTable &&lookup_table);
     virtual ~MergeAndShrinkRepresentationLeaf() = default;
 
     virtual void set_distances(const Distances &) override;
@@ -50,17 +124,27 @@ public:
     virtual int get_value(const State &state) const override;
     virtual bool is_total() const override;
     virtual void dump() const override;
+    virtual void write(disk_cache::CacheWriter &writer) const override;
 };
 
 
 class MergeAndShrinkRepresentationMerge : public MergeAndShrinkRepresentation {
     std::unique_ptr<MergeAndShrinkRepresentation> left_child;
     std::unique_ptr<MergeAndShrinkRepresentation> right_child;
-    std::vector<std::vector<int>> lookup_table;
+    /*
+      The entry for the pair of abstract states (state1, state2) of the
+      children is stored at index state1 * right_domain_size + state2.
+    */
+    const int right_domain_size;
+    LookupTable lookup_table;
 public:
     MergeAndShrinkRepresentationMerge(
         std::unique_ptr<MergeAndShrinkRepresentation> left_child,
         std::unique_ptr<MergeAndShrinkRepresentation> right_child);
+    MergeAndShrinkRepresentationMerge(
+        std::unique_ptr<MergeAndShrinkRepresentation> left_child,
+        std::unique_ptr<MergeAndShrinkRepresentation> right_child,
+        int domain_size, LookupTable &&lookup_table);
     virtual ~MergeAndShrinkRepresentationMerge() = default;
 
     virtual void set_distances(const Distances &distances) override;
@@ -69,6 +153,7 @@ public:
     virtual int get_value(const State &state) const override;
     virtual bool is_total() const override;
     virtual void dump() const override;
+    virtual void write(disk_cache::CacheWriter &writer) const override;
 };
 }
 
@@ -10,6 +10,7 @@
 #include "../options/plugin.h"
 
 #include "../utils/markup.h"
+#include "../utils/thread_pool.h"
 
 #include <cassert>
 
@@ -27,7 +28,7 @@ vector<int> MergeScoringFunctionDFP::compute_label_ranks(
 
     for (GroupAndTransitions gat : ts) {
         const LabelGroup &label_group = gat.label_group;
-        const vector<Transition> &transitions = gat.transitions;
+        TransitionRange transitions = gat.transitions;
         // Relevant labels with no transitions have a rank of infinity.
         int label_rank = INF;
         bool group_relevant = false;
@@ -66,36 +67,48 @@ vector<double> MergeScoringFunctionDFP::compute_scores(
     const vector<pair<int, int>> &merge_candidates) {
     int num_ts = fts.get_size();
 
+    // Compute the label ranks of all transition systems in some candidate.
+    vector<bool> is_candidate_ts(num_ts, false);
+    for (const pair<int, int> &merge_candidate : merge_candidates) {
+        is_candidate_ts[merge_candidate.first] = true;
+        is_candidate_ts[merge_candidate.second] = true;
+    }
+    vector<int> candidate_ts_indices;
+    for (int ts_index = 0; ts_index < num_ts; ++ts_index) {
+        if (is_candidate_ts[ts_index])
+            candidate_ts_indices.push_back(ts_index);
+    }
     vector<vector<int>> transition_system_label_ranks(num_ts);
-    vector<double> scores;
-    scores.reserve(merge_candidates.size());
+    utils::run_in_parallel(
+        candidate_ts_indices.size(), [&](int index, int) {
+            int ts_index = candidate_ts_indices[index];
+            transition_system_label_ranks[ts_index] =
+                compute_label_ranks(fts, ts_index);
+        });
 
     // Go over all pairs of transition systems and compute their weight.
-    for (pair<int, int> merge_candidate : merge_candidates) {
-        int ts_index1 = merge_candidate.first;
-        int ts_index2 = merge_candidate.second;
-
-        vector<int> &label_ranks1 = transition_system_label_ranks[ts_index1];
-        if (label_ranks1.empty()) {
-            label_ranks1 = compute_label_ranks(fts, ts_index1);
-        }
-        vector<int> &label_ranks2 = transition_system_label_ranks[ts_index2];
-        if (label_ranks2.empty()) {
-            label_ranks2 = compute_label_ranks(fts, ts_index2);
-        }
-        assert(label_ranks1.size() == label_ranks2.size());
-
-        // Compute the weight associated with this pair
-        int pair_weight = INF;
-        for (size_t i = 0; i < label_ranks1.size(); ++i) {
-            if (label_ranks1[i] != -1 && label_ranks2[i] != -1) {
-                // label is relevant in both transition_systems
-                int max_label_rank = max(label_ranks1[i], label_ranks2[i]);
-                pair_weight = min(pair_weight, max_label_rank);
+    int num_candidates = merge_candidates.size();
+    vector<double> scores(num_candidates);
+    utils::run_in_parallel(
+        num_candidates, [&](int candidate_index, int) {
+            const pair<int, int> &merge_candidate = merge_candidates[candidate_index];
+            const vector<int> &label_ranks1 =
+                transition_system_label_ranks[merge_candidate.first];
+            const vector<int> &label_ranks2 =
+                transition_system_label_ranks[merge_candidate.second];
+            assert(label_ranks1.size() == label_ranks2.size());
+
+            // Compute the weight associated with this pair
+            int pair_weight = INF;
+            for (size_t i = 0; i < label_ranks1.size(); ++i) {
+                if (label_ranks1[i] != -1 && label_ranks2[i] != -1) {
+                    // label is relevant in both transition_systems
+                    int max_label_rank = max(label_ranks1[i], label_ranks2[i]);
+                    pair_weight = min(pair_weight, max_label_rank);
+                }
             }
-        }
-        scores.push_back(pair_weight);
-    }
+            scores[candidate_index] = pair_weight;
+        });
     return scores;
 }
 
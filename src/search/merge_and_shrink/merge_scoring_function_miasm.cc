@@ -13,6 +13,7 @@
 
 #include "../utils/logging.h"
 #include "../utils/markup.h"
+#include "../utils/thread_pool.h"
 
 using namespace std;
 
@@ -25,46 +26,63 @@ MergeScoringFunctionMIASM::MergeScoringFunctionMIASM(
       shrink_threshold_before_merge(options.get<int>("threshold_before_merge")) {
 }
 
+double MergeScoringFunctionMIASM::compute_score(
+    const FactoredTransitionSystem &fts,
+    const pair<int, int> &merge_candidate) const {
+    int index1 = merge_candidate.first;
+    int index2 = merge_candidate.second;
+    unique_ptr<TransitionSystem> product = shrink_before_merge_externally(
+        fts,
+        index1,
+        index2,
+        *shrink_strategy,
+        max_states,
+        max_states_before_merge,
+        shrink_threshold_before_merge);
+
+    // Compute distances for the product and count the alive states.
+    unique_ptr<Distances> distances = utils::make_unique_ptr<Distances>(*product);
+    const bool compute_init_distances = true;
+    const bool compute_goal_distances = true;
+    const utils::Verbosity verbosity = utils::Verbosity::SILENT;
+    distances->compute_distances(compute_init_distances, compute_goal_distances, verbosity);
+    int num_states = product->get_size();
+    int alive_states_count = 0;
+    for (int state = 0; state < num_states; ++state) {
+        if (distances->get_init_distance(state) != INF &&
+            distances->get_goal_distance(state) != INF) {
+            ++alive_states_count;
+        }
+    }
+
+    /*
+      Compute the score as the ratio of alive states of the product
+      compared to the number of states of the full product.
+    */
+    assert(num_states);
+    return static_cast<double>(alive_states_count) /
+           static_cast<double>(num_states);
+}
+
 vector<double> MergeScoringFunctionMIASM::compute_scores(
     const FactoredTransitionSystem &fts,
     const vector<pair<int, int>> &merge_candidates) {
-    vector<double> scores;
-    scores.reserve(merge_candidates.size());
-    for (pair<int, int> merge_candidate : merge_candidates) {
-        int index1 = merge_candidate.first;
-        int index2 = merge_candidate.second;
-        unique_ptr<TransitionSystem> product = shrink_before_merge_externally(
-            fts,
-            index1,
-            index2,
-            *shrink_strategy,
-            max_states,
-            max_states_before_merge,
-            shrink_threshold_before_merge);
-
-        // Compute distances for the product and count the alive states.
-        unique_ptr<Distances> distances = utils::make_unique_ptr<Distances>(*product);
-        const bool compute_init_distances = true;
-        const bool compute_goal_distances = true;
-        const utils::Verbosity verbosity = utils::Verbosity::SILENT;
-        distances->compute_distances(compute_init_distances, compute_goal_distances, verbosity);
-        int num_states = product->get_size();
-        int alive_states_count = 0;
-        for (int state = 0; state < num_states; ++state) {
-            if (distances->get_init_distance(state) != INF &&
-                distances->get_goal_distance(state) != INF) {
-                ++alive_states_count;
-            }
+    /*
+      Every candidate product is built from its own copies of the factors,
+      so the candidates can be scored in parallel unless shrinking makes
+      random choices.
+    */
+    int num_candidates = merge_candidates.size();
+    vector<double> scores(num_candidates);
+    auto compute_candidate_score = [&](int index, int) {
+            scores[index] = compute_score(fts, merge_candidates[index]);
+        };
+    if (shrink_strategy->supports_parallel_computation()) {
+        utils::run_in_parallel(num_candidates, compute_candidate_score);
+    } else {
+        for (int index = 0; index < num_candidates; ++index) {
+            compute_candidate_score(index, 0);
         }
-
-        /*
-          Compute the score as the ratio of alive states of the product
-          compared to the number of states of the full product.
-        */
-        assert(num_states);
-        double score = static_cast<double>(alive_states_count) /
-            static_cast<double>(num_states);
-        scores.push_back(score);
     }
     return scores;
 }
@@ -16,6 +16,10 @@ class MergeScoringFunctionMIASM : public MergeScoringFunction {
     const int max_states;
     const int max_states_before_merge;
     const int shrink_threshold_before_merge;
+
+    double compute_score(
+        const FactoredTransitionSystem &fts,
+        const std::pair<int, int> &merge_candidate) const;
 protected:
     virtual std::string name() const override;
 public:
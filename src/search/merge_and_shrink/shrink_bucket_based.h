@@ -56,6 +56,10 @@ public:
         const TransitionSystem &ts,
         const Distances &distances,
         int target_size) const override;
+    // The random choices depend on the order of the calls.
+    virtual bool supports_parallel_computation() const override {
+        return false;
+    }
     static void add_options_to_parser(options::OptionParser &parser);
 };
 }
@@ -39,6 +39,15 @@ public:
     virtual bool requires_init_distances() const = 0;
     virtual bool requires_goal_distances() const = 0;
 
+    /*
+      Return true iff compute_equivalence_relation can be called for
+      different transition systems concurrently, with results that do not
+      depend on the order of the calls.
+    */
+    virtual bool supports_parallel_computation() const {
+        return true;
+    }
+
     void dump_options() const;
     std::string get_name() const;
 };
@@ -4,7 +4,6 @@
 #include "label_equivalence_relation.h"
 #include "labels.h"
 
-#include "../utils/collections.h"
 #include "../utils/logging.h"
 #include "../utils/memory.h"
 #include "../utils/system.h"
@@ -13,7 +12,6 @@
 #include <cassert>
 #include <iostream>
 #include <iterator>
-#include <set>
 #include <sstream>
 #include <string>
 #include <unordered_map>
@@ -28,18 +26,14 @@ ostream &operator<<(ostream &os, const Transition &trans) {
     return os;
 }
 
-// Sorts the given set of transitions and removes duplicates.
-static void normalize_given_transitions(vector<Transition> &transitions) {
-    sort(transitions.begin(), transitions.end());
-    transitions.erase(unique(transitions.begin(), transitions.end()), transitions.end());
-}
-
 TSConstIterator::TSConstIterator(
     const LabelEquivalenceRelation &label_equivalence_relation,
-    const vector<vector<Transition>> &transitions_by_group_id,
+    const vector<Transition> &transitions,
+    const vector<size_t> &group_offsets,
     bool end)
     : label_equivalence_relation(label_equivalence_relation),
-      transitions_by_group_id(transitions_by_group_id),
+      transitions(transitions),
+      group_offsets(group_offsets),
       current_group_id((end ? label_equivalence_relation.get_size() : 0)) {
     next_valid_index();
 }
@@ -59,7 +53,9 @@ void TSConstIterator::operator++() {
 GroupAndTransitions TSConstIterator::operator*() const {
     return GroupAndTransitions(
         label_equivalence_relation.get_group(current_group_id),
-        transitions_by_group_id[current_group_id]);
+        TransitionRange(
+            transitions.data() + group_offsets[current_group_id],
+            transitions.data() + group_offsets[current_group_id + 1]));
 }
 
 
@@ -82,14 +78,16 @@ TransitionSystem::TransitionSystem(
     int num_variables,
     vector<int> &&incorporated_variables,
     unique_ptr<LabelEquivalenceRelation> &&label_equivalence_relation,
-    vector<vector<Transition>> &&transitions_by_group_id,
+    vector<Transition> &&transitions,
+    vector<size_t> &&group_offsets,
     int num_states,
     vector<bool> &&goal_states,
     int init_state)
     : num_variables(num_variables),
       incorporated_variables(move(incorporated_variables)),
       label_equivalence_relation(move(label_equivalence_relation)),
-      transitions_by_group_id(move(transitions_by_group_id)),
+      transitions(move(transitions)),
+      group_offsets(move(group_offsets)),
       num_states(num_states),
       goal_states(move(goal_states)),
       init_state(init_state) {
@@ -103,7 +101,8 @@ TransitionSystem::TransitionSystem(const TransitionSystem &other)
       label_equivalence_relation(
           utils::make_unique_ptr<LabelEquivalenceRelation>(
               *other.label_equivalence_relation)),
-      transitions_by_group_id(other.transitions_by_group_id),
+      transitions(other.transitions),
+      group_offsets(other.group_offsets),
       num_states(other.num_states),
       goal_states(other.goal_states),
       init_state(other.init_state) {
@@ -132,8 +131,6 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
         ts2.incorporated_variables.begin(), ts2.incorporated_variables.end(),
         back_inserter(incorporated_variables));
     vector<vector<int>> label_groups;
-    vector<vector<Transition>> transitions_by_group_id;
-    transitions_by_group_id.reserve(labels.get_max_size());
 
     int ts1_size = ts1.get_size();
     int ts2_size = ts2.get_size();
@@ -160,12 +157,22 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
       (B) they are both dead in T (e.g., this includes the case where
           l is dead in T1 only and l' is dead in T2 only, so they are not
           locally equivalent in either of the components).
+
+      We first compute the new groups together with the transitions of the
+      two components they combine. This lets us allocate the transitions of
+      the composite at once before creating them.
     */
-    int multiplier = ts2_size;
+    struct NewGroup {
+        TransitionRange transitions1;
+        TransitionRange transitions2;
+        vector<int> labels;
+    };
+    vector<NewGroup> new_groups;
     vector<int> dead_labels;
+    size_t num_transitions = 0;
     for (GroupAndTransitions gat : ts1) {
         const LabelGroup &group1 = gat.label_group;
-        const vector<Transition> &transitions1 = gat.transitions;
+        TransitionRange transitions1 = gat.transitions;
 
         // Distribute the labels of this group among the "buckets"
         // corresponding to the groups of ts2.
@@ -177,41 +184,49 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
         // Now buckets contains all equivalence classes that are
         // refinements of group1.
 
-        // Now create the new groups together with their transitions.
         for (auto &bucket : buckets) {
-            const vector<Transition> &transitions2 =
+            TransitionRange transitions2 =
                 ts2.get_transitions_for_group_id(bucket.first);
-
-            // Create the new transitions for this bucket
-            vector<Transition> new_transitions;
-            if (!transitions1.empty() && !transitions2.empty()
-                && transitions1.size() > new_transitions.max_size() / transitions2.size())
-                utils::exit_with(ExitCode::SEARCH_OUT_OF_MEMORY);
-            new_transitions.reserve(transitions1.size() * transitions2.size());
-            for (const Transition &transition1 : transitions1) {
-                int src1 = transition1.src;
-                int target1 = transition1.target;
-                for (const Transition &transition2 : transitions2) {
-                    int src2 = transition2.src;
-                    int target2 = transition2.target;
-                    int src = src1 * multiplier + src2;
-                    int target = target1 * multiplier + target2;
-                    new_transitions.push_back(Transition(src, target));
-                }
-            }
-
-            // Create a new group if the transitions are not empty
             vector<int> &new_labels = bucket.second;
-            if (new_transitions.empty()) {
+            if (transitions1.empty() || transitions2.empty()) {
                 dead_labels.insert(dead_labels.end(), new_labels.begin(), new_labels.end());
             } else {
-                sort(new_transitions.begin(), new_transitions.end());
-                label_groups.push_back(move(new_labels));
-                transitions_by_group_id.push_back(move(new_transitions));
+                size_t max_transitions = vector<Transition>().max_size();
+                if (transitions1.size() > max_transitions / transitions2.size()
+                    || transitions1.size() * transitions2.size() >
+                    max_transitions - num_transitions)
+                    utils::exit_with(ExitCode::SEARCH_OUT_OF_MEMORY);
+                num_transitions += transitions1.size() * transitions2.size();
+                new_groups.push_back({transitions1, transitions2, move(new_labels)});
             }
         }
     }
 
+    // Now create the new groups together with their transitions.
+    int multiplier = ts2_size;
+    vector<Transition> transitions;
+    transitions.reserve(num_transitions);
+    vector<size_t> group_offsets;
+    group_offsets.reserve(new_groups.size() + 2);
+    group_offsets.push_back(0);
+    for (NewGroup &new_group : new_groups) {
+        for (const Transition &transition1 : new_group.transitions1) {
+            int src1 = transition1.src;
+            int target1 = transition1.target;
+            for (const Transition &transition2 : new_group.transitions2) {
+                int src2 = transition2.src;
+                int target2 = transition2.target;
+                int src = src1 * multiplier + src2;
+                int target = target1 * multiplier + target2;
+                transitions.push_back(Transition(src, target));
+            }
+        }
+        sort(transitions.begin() + group_offsets.back(), transitions.end());
+        group_offsets.push_back(transitions.size());
+        label_groups.push_back(move(new_group.labels));
+    }
+    assert(transitions.size() == num_transitions);
+
     /*
       We collect all dead labels separately, because the bucket refining
       does not work in cases where there are at least two dead labels l1
@@ -222,10 +237,10 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
     if (!dead_labels.empty()) {
         label_groups.push_back(move(dead_labels));
         // Dead labels have empty transitions
-        transitions_by_group_id.emplace_back();
+        group_offsets.push_back(transitions.size());
     }
 
-    assert(transitions_by_group_id.size() == label_groups.size());
+    assert(group_offsets.size() == label_groups.size() + 1);
 
     unique_ptr<LabelEquivalenceRelation> label_equivalence_relation =
         utils::make_unique_ptr<LabelEquivalenceRelation>(labels, label_groups);
@@ -234,7 +249,8 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
         num_variables,
         move(incorporated_variables),
         move(label_equivalence_relation),
-        move(transitions_by_group_id),
+        move(transitions),
+        move(group_offsets),
         num_states,
         move(goal_states),
         init_state
@@ -246,23 +262,48 @@ void TransitionSystem::compute_locally_equivalent_labels() {
       Compare every group of labels and their transitions to all others and
       merge two groups whenever the transitions are the same.
     */
+    bool groups_merged = false;
     for (int group_id1 = 0; group_id1 < label_equivalence_relation->get_size();
          ++group_id1) {
         if (!label_equivalence_relation->is_empty_group(group_id1)) {
-            const vector<Transition> &transitions1 = transitions_by_group_id[group_id1];
+            TransitionRange transitions1 = get_transitions_for_group_id(group_id1);
             for (int group_id2 = group_id1 + 1;
                  group_id2 < label_equivalence_relation->get_size(); ++group_id2) {
                 if (!label_equivalence_relation->is_empty_group(group_id2)) {
-                    vector<Transition> &transitions2 = transitions_by_group_id[group_id2];
-                    if (transitions1 == transitions2) {
+                    TransitionRange transitions2 = get_transitions_for_group_id(group_id2);
+                    if (transitions1.size() == transitions2.size() &&
+                        equal(transitions1.begin(), transitions1.end(),
+                              transitions2.begin())) {
                         label_equivalence_relation->move_group_into_group(
                             group_id2, group_id1);
-                        utils::release_vector_memory(transitions2);
+                        groups_merged = true;
                     }
                 }
             }
         }
     }
+    if (groups_merged) {
+        remove_transitions_of_empty_groups();
+    }
+}
+
+void TransitionSystem::remove_transitions_of_empty_groups() {
+    int num_groups = group_offsets.size() - 1;
+    size_t new_end = 0;
+    for (int group_id = 0; group_id < num_groups; ++group_id) {
+        size_t begin = group_offsets[group_id];
+        size_t end = group_offsets[group_id + 1];
+        group_offsets[group_id] = new_end;
+        if (!label_equivalence_relation->is_empty_group(group_id)) {
+            if (begin != new_end) {
+                move(transitions.begin() + begin, transitions.begin() + end,
+                     transitions.begin() + new_end);
+            }
+            new_end += end - begin;
+        }
+    }
+    group_offsets[num_groups] = new_end;
+    transitions.erase(transitions.begin() + new_end, transitions.end());
 }
 
 void TransitionSystem::apply_abstraction(
@@ -294,34 +335,40 @@ void TransitionSystem::apply_abstraction(
     }
     goal_states = move(new_goal_states);
 
-    // Update all transitions.
-    for (vector<Transition> &transitions : transitions_by_group_id) {
-        if (!transitions.empty()) {
-            vector<Transition> new_transitions;
-            /*
-              We reserve more memory than necessary here, but this is better
-              than potentially resizing the vector several times when inserting
-              transitions one after the other. See issue604-v6.
-
-              An alternative could be to not use a new vector, but to modify
-              the existing transitions inplace, and to remove all empty
-              positions in the end. This would be more ugly, though.
-            */
-            new_transitions.reserve(transitions.size());
-            for (size_t i = 0; i < transitions.size(); ++i) {
-                const Transition &transition = transitions[i];
-                int src = abstraction_mapping[transition.src];
-                int target = abstraction_mapping[transition.target];
-                if (src != PRUNED_STATE && target != PRUNED_STATE)
-                    new_transitions.push_back(Transition(src, target));
-            }
-            normalize_given_transitions(new_transitions);
-            transitions = move(new_transitions);
+    /*
+      Update all transitions in place. Every group has at most as many
+      transitions after the update as before, so the new transitions of a
+      group never overwrite transitions that have not been mapped yet.
+    */
+    int num_groups = group_offsets.size() - 1;
+    size_t new_end = 0;
+    for (int group_id = 0; group_id < num_groups; ++group_id) {
+        size_t begin = group_offsets[group_id];
+        size_t end = group_offsets[group_id + 1];
+        size_t new_begin = new_end;
+        group_offsets[group_id] = new_begin;
+        for (size_t i = begin; i < end; ++i) {
+            const Transition &transition = transitions[i];
+            int src = abstraction_mapping[transition.src];
+            int target = abstraction_mapping[transition.target];
+            if (src != PRUNED_STATE && target != PRUNED_STATE)
+                transitions[new_end++] = Transition(src, target);
         }
+        auto group_begin = transitions.begin() + new_begin;
+        auto group_end = transitions.begin() + new_end;
+        sort(group_begin, group_end);
+        new_end = unique(group_begin, group_end) - transitions.begin();
     }
+    group_offsets[num_groups] = new_end;
+    transitions.erase(transitions.begin() + new_end, transitions.end());
 
     compute_locally_equivalent_labels();
 
+    // Give memory back if shrinking removed most of the transitions.
+    if (transitions.size() < transitions.capacity() / 2) {
+        transitions.shrink_to_fit();
+    }
+
     num_states = new_num_states;
     init_state = abstraction_mapping[init_state];
     if (verbosity >= utils::Verbosity::VERBOSE && init_state == PRUNED_STATE) {
@@ -372,26 +419,30 @@ void TransitionSystem::apply_label_reduction(
           updating label_equivalence_relation, because after updating it,
           we cannot find out the group ID of reduced labels anymore.
         */
-        vector<vector<Transition>> new_transitions;
-        new_transitions.reserve(label_mapping.size());
+        vector<Transition> new_transitions;
+        vector<size_t> new_group_offsets(1, 0);
+        new_group_offsets.reserve(label_mapping.size() + 1);
         unordered_set<int> affected_group_ids;
         for (const pair<int, vector<int>> &mapping: label_mapping) {
             const vector<int> &old_label_nos = mapping.second;
             assert(old_label_nos.size() >= 2);
             unordered_set<int> seen_group_ids;
-            set<Transition> new_label_transitions;
             for (int old_label_no : old_label_nos) {
                 int group_id = label_equivalence_relation->get_group_id(old_label_no);
                 if (seen_group_ids.insert(group_id).second) {
                     affected_group_ids.insert(group_id);
-                    const vector<Transition> &transitions = transitions_by_group_id[group_id];
-                    new_label_transitions.insert(transitions.begin(), transitions.end());
+                    TransitionRange old_transitions = get_transitions_for_group_id(group_id);
+                    new_transitions.insert(new_transitions.end(),
+                                           old_transitions.begin(), old_transitions.end());
                 }
             }
-            new_transitions.emplace_back(
-                new_label_transitions.begin(), new_label_transitions.end());
+            auto group_begin = new_transitions.begin() + new_group_offsets.back();
+            sort(group_begin, new_transitions.end());
+            new_transitions.erase(
+                unique(group_begin, new_transitions.end()), new_transitions.end());
+            new_group_offsets.push_back(new_transitions.size());
         }
-        assert(label_mapping.size() == new_transitions.size());
+        assert(label_mapping.size() + 1 == new_group_offsets.size());
 
         /*
            Apply all label mappings to label_equivalence_relation. This needs
@@ -402,27 +453,23 @@ void TransitionSystem::apply_label_reduction(
         */
         label_equivalence_relation->apply_label_mapping(label_mapping, &affected_group_ids);
 
+        // Remove the transitions of old groups that became empty.
+        remove_transitions_of_empty_groups();
+
         /*
-          Go over the transitions of new labels and add them at the correct
-          position.
+          Go over the transitions of new labels and add them at the end.
 
           NOTE: it is important that this happens in increasing order of label
-          numbers to ensure that transitions_by_group_id are synchronized with
-          label groups of label_equivalence_relation.
+          numbers to ensure that group_offsets are synchronized with label
+          groups of label_equivalence_relation.
         */
+        size_t old_num_transitions = transitions.size();
+        transitions.insert(transitions.end(),
+                           new_transitions.begin(), new_transitions.end());
         for (size_t i = 0; i < label_mapping.size(); ++i) {
-            vector<Transition> &transitions = new_transitions[i];
             assert(label_equivalence_relation->get_group_id(label_mapping[i].first)
-                   == static_cast<int>(transitions_by_group_id.size()));
-            transitions_by_group_id.push_back(move(transitions));
-        }
-
-        // Go over all affected group IDs and remove their transitions if the
-        // group is empty.
-        for (int group_id : affected_group_ids) {
-            if (label_equivalence_relation->is_empty_group(group_id)) {
-                utils::release_vector_memory(transitions_by_group_id[group_id]);
-            }
+                   == static_cast<int>(group_offsets.size()) - 1);
+            group_offsets.push_back(old_num_transitions + new_group_offsets[i + 1]);
         }
 
         compute_locally_equivalent_labels();
@@ -440,7 +487,10 @@ string TransitionSystem::tag() const {
 
 bool TransitionSystem::are_transitions_sorted_unique() const {
     for (GroupAndTransitions gat : *this) {
-        if (!utils::is_sorted_unique(gat.transitions))
+        if (adjacent_find(gat.transitions.begin(), gat.transitions.end(),
+                          [](const Transition &t1, const Transition &t2) {
+                              return t1 >= t2;
+                          }) != gat.transitions.end())
             return false;
     }
     return true;
@@ -448,7 +498,12 @@ bool TransitionSystem::are_transitions_sorted_unique() const {
 
 bool TransitionSystem::in_sync_with_label_equivalence_relation() const {
     return label_equivalence_relation->get_size() ==
-           static_cast<int>(transitions_by_group_id.size());
+           static_cast<int>(group_offsets.size()) - 1 &&
+           group_offsets.back() == transitions.size();
+}
+
+int TransitionSystem::get_label_group_id(int label_no) const {
+    return label_equivalence_relation->get_group_id(label_no);
 }
 
 bool TransitionSystem::is_solvable(const Distances &distances) const {
@@ -497,7 +552,7 @@ void TransitionSystem::dump_dot_graph() const {
     }
     for (GroupAndTransitions gat : *this) {
         const LabelGroup &label_group = gat.label_group;
-        const vector<Transition> &transitions = gat.transitions;
+        TransitionRange transitions = gat.transitions;
         for (const Transition &transition : transitions) {
             int src = transition.src;
             int target = transition.target;
@@ -528,7 +583,7 @@ void TransitionSystem::dump_labels_and_transitions() const {
         }
         utils::g_log << endl;
         utils::g_log << "transitions: ";
-        const vector<Transition> &transitions = gat.transitions;
+        TransitionRange transitions = gat.transitions;
         for (size_t i = 0; i < transitions.size(); ++i) {
             int src = transitions[i].src;
             int target = transitions[i].target;
@@ -3,6 +3,7 @@
 
 #include "types.h"
 
+#include <cstddef>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -41,11 +42,45 @@ struct Transition {
     }
 };
 
+/*
+  Read-only view of the transitions of a label group. The transitions of
+  all groups of a transition system are stored consecutively in a single
+  array, see TransitionSystem.
+*/
+class TransitionRange {
+    const Transition *first;
+    const Transition *last;
+public:
+    TransitionRange(const Transition *first, const Transition *last)
+        : first(first), last(last) {
+    }
+
+    const Transition *begin() const {
+        return first;
+    }
+
+    const Transition *end() const {
+        return last;
+    }
+
+    std::size_t size() const {
+        return last - first;
+    }
+
+    bool empty() const {
+        return first == last;
+    }
+
+    const Transition &operator[](std::size_t index) const {
+        return first[index];
+    }
+};
+
 struct GroupAndTransitions {
     const LabelGroup &label_group;
-    const std::vector<Transition> &transitions;
+    TransitionRange transitions;
     GroupAndTransitions(const LabelGroup &label_group,
-                        const std::vector<Transition> &transitions)
+                        TransitionRange transitions)
         : label_group(label_group),
           transitions(transitions) {
     }
@@ -59,14 +94,16 @@ class TSConstIterator {
       easily exchanged.
     */
     const LabelEquivalenceRelation &label_equivalence_relation;
-    const std::vector<std::vector<Transition>> &transitions_by_group_id;
+    const std::vector<Transition> &transitions;
+    const std::vector<std::size_t> &group_offsets;
     // current_group_id is the actual iterator
     int current_group_id;
 
     void next_valid_index();
 public:
     TSConstIterator(const LabelEquivalenceRelation &label_equivalence_relation,
-                    const std::vector<std::vector<Transition>> &transitions_by_group_id,
+                    const std::vector<Transition> &transitions,
+                    const std::vector<std::size_t> &group_offsets,
                     bool end);
     void operator++();
     GroupAndTransitions operator*() const;
@@ -104,17 +141,19 @@ private:
     std::unique_ptr<LabelEquivalenceRelation> label_equivalence_relation;
 
     /*
-      The transitions of a label group are indexed via its ID. The ID of a
-      group does not change, and hence its transitions are never moved.
-
-      We tested different alternatives to store the transitions, but they all
-      performed worse: storing a vector transitions in the label group increases
-      memory usage and runtime; storing the transitions more compactly and
-      incrementally increasing the size of transitions_of_groups whenever a
-      new label group is added also increases runtime. See also issue492 and
-      issue521.
+      The transitions of all label groups are stored in compressed sparse
+      row format: the transitions of the group with ID i are
+      transitions[group_offsets[i]], ..., transitions[group_offsets[i + 1] - 1].
+      The ID of a group does not change. Groups that become empty keep their
+      ID but get an empty range.
+
+      Compared to storing one vector of transitions per group, this avoids
+      many small allocations and lets us apply abstractions and label
+      reductions in place, without allocating a second copy of the
+      transitions.
     */
-    std::vector<std::vector<Transition>> transitions_by_group_id;
+    std::vector<Transition> transitions;
+    std::vector<std::size_t> group_offsets;
 
     int num_states;
     std::vector<bool> goal_states;
@@ -126,8 +165,16 @@ private:
     */
     void compute_locally_equivalent_labels();
 
-    const std::vector<Transition> &get_transitions_for_group_id(int group_id) const {
-        return transitions_by_group_id[group_id];
+    /*
+      Remove the transitions of all empty label groups from the transition
+      array by moving the transitions of the remaining groups to the front.
+    */
+    void remove_transitions_of_empty_groups();
+
+    TransitionRange get_transitions_for_group_id(int group_id) const {
+        return TransitionRange(
+            transitions.data() + group_offsets[group_id],
+            transitions.data() + group_offsets[group_id + 1]);
     }
 
     // Statistics and output
@@ -138,7 +185,8 @@ public:
         int num_variables,
         std::vector<int> &&incorporated_variables,
         std::unique_ptr<LabelEquivalenceRelation> &&label_equivalence_relation,
-        std::vector<std::vector<Transition>> &&transitions_by_group_id,
+        std::vector<Transition> &&transitions,
+        std::vector<std::size_t> &&group_offsets,
         int num_states,
         std::vector<bool> &&goal_states,
         int init_state);
@@ -179,13 +227,15 @@ public:
 
     TSConstIterator begin() const {
         return TSConstIterator(*label_equivalence_relation,
-                               transitions_by_group_id,
+                               transitions,
+                               group_offsets,
                                false);
     }
 
     TSConstIterator end() const {
         return TSConstIterator(*label_equivalence_relation,
-                               transitions_by_group_id,
+                               transitions,
+                               group_offsets,
                                true);
     }
 
@@ -225,6 +275,9 @@ public:
     const std::vector<int> &get_incorporated_variables() const {
         return incorporated_variables;
     }
+
+    // Return the ID of the group of locally equivalent labels of the label.
+    int get_label_group_id(int label_no) const;
 };
 }
 
@@ -2,6 +2,7 @@
 #define OPEN_LIST_H
 
 #include <set>
+#include <vector>
 
 #include "evaluation_context.h"
 #include "operator_id.h"
@@ -90,6 +91,15 @@ public:
     virtual void get_path_dependent_evaluators(
         std::set<Evaluator *> &evals) = 0;
 
+    /*
+      Compute the results of all evaluators used by this open list for a
+      batch of evaluation contexts, e.g., for the successors of an
+      expansion (see Evaluator::compute_results). The results are cached in
+      the contexts, so inserting them afterwards does not evaluate again.
+    */
+    virtual void compute_results(
+        const std::vector<EvaluationContext *> &eval_contexts) = 0;
+
     /*
       Accessor method for only_preferred.
 
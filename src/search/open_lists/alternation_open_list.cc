@@ -35,6 +35,8 @@ public:
     virtual void boost_preferred() override;
     virtual void get_path_dependent_evaluators(
         set<Evaluator *> &evals) override;
+    virtual void compute_results(
+        const vector<EvaluationContext *> &eval_contexts) override;
     virtual bool is_dead_end(
         EvaluationContext &eval_context) const override;
     virtual bool is_reliable_dead_end(
@@ -105,6 +107,13 @@ void AlternationOpenList<Entry>::get_path_dependent_evaluators(
         sublist->get_path_dependent_evaluators(evals);
 }
 
+template<class Entry>
+void AlternationOpenList<Entry>::compute_results(
+    const vector<EvaluationContext *> &eval_contexts) {
+    for (const auto &sublist : open_lists)
+        sublist->compute_results(eval_contexts);
+}
+
 template<class Entry>
 bool AlternationOpenList<Entry>::is_dead_end(
     EvaluationContext &eval_context) const {
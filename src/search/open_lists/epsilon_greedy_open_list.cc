@@ -55,6 +55,8 @@ public:
     virtual bool is_reliable_dead_end(
         EvaluationContext &eval_context) const override;
     virtual void get_path_dependent_evaluators(set<Evaluator *> &evals) override;
+    virtual void compute_results(
+        const vector<EvaluationContext *> &eval_contexts) override;
     virtual bool empty() const override;
     virtual void clear() override;
 };
@@ -124,6 +126,12 @@ void EpsilonGreedyOpenList<Entry>::get_path_dependent_evaluators(
     evaluator->get_path_dependent_evaluators(evals);
 }
 
+template<class Entry>
+void EpsilonGreedyOpenList<Entry>::compute_results(
+    const vector<EvaluationContext *> &eval_contexts) {
+    evaluator->compute_results(eval_contexts);
+}
+
 template<class Entry>
 bool EpsilonGreedyOpenList<Entry>::empty() const {
     return size == 0;
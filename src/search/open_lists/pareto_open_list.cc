@@ -6,39 +6,199 @@
 #include "../plugin.h"
 
 #include "../utils/hash.h"
+#include "../utils/language.h"
 #include "../utils/memory.h"
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
 
+#include <array>
 #include <cassert>
 #include <deque>
+#include <limits>
 #include <set>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
 using namespace std;
 
 namespace pareto_open_list {
-template<class Entry>
+template<class Key>
+static bool dominates(const Key &v1, const Key &v2) {
+    assert(v1.size() == v2.size());
+    bool are_different = false;
+    for (size_t i = 0; i < v1.size(); ++i) {
+        if (v1[i] > v2[i])
+            return false;
+        else if (v1[i] < v2[i])
+            are_different = true;
+    }
+    return are_different;
+}
+
+/*
+  A skyline stores a set of keys and maintains the subset of keys that
+  are not dominated by other keys of the set. Keys can only be dominated
+  by lexicographically smaller keys, so we order all keys
+  lexicographically.
+*/
+class GeneralSkyline {
+public:
+    using Key = vector<int>;
+    using KeySet = set<Key>;
+
+private:
+    KeySet keys;
+    KeySet nondominated;
+
+public:
+    static Key create_key(int dimension) {
+        return Key(dimension);
+    }
+
+    // The key must not be in the skyline yet.
+    void insert(const Key &key) {
+        assert(!keys.count(key));
+        keys.insert(key);
+        auto it = nondominated.begin();
+        auto end = nondominated.lower_bound(key);
+        for (; it != end; ++it) {
+            if (dominates(*it, key))
+                return;
+        }
+        // Delete previously nondominated keys that are now dominated by key.
+        while (it != nondominated.end()) {
+            if (dominates(key, *it))
+                it = nondominated.erase(it);
+            else
+                ++it;
+        }
+        nondominated.insert(key);
+    }
+
+    // The key must be in the set of nondominated keys.
+    void erase(const Key &key) {
+        assert(nondominated.count(key));
+        keys.erase(key);
+        nondominated.erase(key);
+        /*
+          Only keys that were dominated by key can become nondominated.
+          We visit them in lexicographic order, so all keys that can
+          dominate a key have been added to the nondominated keys
+          before we test it.
+        */
+        for (auto it = keys.upper_bound(key); it != keys.end(); ++it) {
+            const Key &candidate = *it;
+            if (dominates(key, candidate)) {
+                bool is_nondominated = true;
+                for (const Key &other : nondominated) {
+                    if (dominates(other, candidate)) {
+                        is_nondominated = false;
+                        break;
+                    }
+                }
+                if (is_nondominated)
+                    nondominated.insert(candidate);
+            }
+        }
+    }
+
+    const KeySet &get_nondominated() const {
+        return nondominated;
+    }
+
+    void clear() {
+        keys.clear();
+        nondominated.clear();
+    }
+};
+
+
+/*
+  In two dimensions, the nondominated keys form a staircase: ordered by
+  their first components, their second components strictly decrease.
+  We can therefore find the keys that dominate or are dominated by a new
+  key with a logarithmic search. When a nondominated key is erased, only
+  keys between its neighbors on the staircase can take its place. We
+  find them by visiting the key with the smallest second component for
+  each first component in that range.
+*/
+class TwoDimensionalSkyline {
+public:
+    using Key = array<int, 2>;
+    using KeySet = set<Key>;
+
+private:
+    KeySet keys;
+    KeySet nondominated;
+
+public:
+    static Key create_key(int dimension) {
+        utils::unused_variable(dimension);
+        assert(dimension == 2);
+        return Key();
+    }
+
+    // The key must not be in the skyline yet.
+    void insert(const Key &key) {
+        assert(!keys.count(key));
+        keys.insert(key);
+        /*
+          Of all nondominated keys that are lexicographically smaller than
+          key, the last one has the smallest second component.
+        */
+        auto it = nondominated.lower_bound(key);
+        if (it != nondominated.begin() && (*prev(it))[1] <= key[1])
+            return;
+        // Delete previously nondominated keys that are now dominated by key.
+        while (it != nondominated.end() && (*it)[1] >= key[1])
+            it = nondominated.erase(it);
+        nondominated.insert(it, key);
+    }
+
+    // The key must be in the set of nondominated keys.
+    void erase(const Key &key) {
+        assert(nondominated.count(key));
+        keys.erase(key);
+        auto next = nondominated.erase(nondominated.find(key));
+        bool has_previous = next != nondominated.begin();
+        int previous_second = has_previous ? (*prev(next))[1] : 0;
+        auto it = keys.upper_bound(key);
+        while (it != keys.end() &&
+               (next == nondominated.end() || (*it)[0] < (*next)[0])) {
+            const Key &candidate = *it;
+            if (!has_previous || candidate[1] < previous_second) {
+                nondominated.insert(next, candidate);
+                has_previous = true;
+                previous_second = candidate[1];
+            }
+            it = keys.upper_bound(Key{{candidate[0], numeric_limits<int>::max()}});
+        }
+    }
+
+    const KeySet &get_nondominated() const {
+        return nondominated;
+    }
+
+    void clear() {
+        keys.clear();
+        nondominated.clear();
+    }
+};
+
+
+template<class Entry, class Skyline>
 class ParetoOpenList : public OpenList<Entry> {
     shared_ptr<utils::RandomNumberGenerator> rng;
 
     using Bucket = deque<Entry>;
-    using KeyType = vector<int>;
-    using BucketMap = utils::HashMap<KeyType, Bucket>;
-    using KeySet = set<KeyType>;
+    using Key = typename Skyline::Key;
+    using BucketMap = utils::HashMap<Key, Bucket>;
 
     BucketMap buckets;
-    KeySet nondominated;
+    Skyline skyline;
     bool state_uniform_selection;
     vector<shared_ptr<Evaluator>> evaluators;
 
-    bool dominates(const KeyType &v1, const KeyType &v2) const;
-    bool is_nondominated(
-        const KeyType &vec, KeySet &domination_candidates) const;
-    void remove_key(const KeyType &key);
-
 protected:
     virtual void do_insertion(EvaluationContext &eval_context,
                               const Entry &entry) override;
@@ -51,117 +211,41 @@ public:
     virtual bool empty() const override;
     virtual void clear() override;
     virtual void get_path_dependent_evaluators(set<Evaluator *> &evals) override;
+    virtual void compute_results(
+        const vector<EvaluationContext *> &eval_contexts) override;
     virtual bool is_dead_end(
         EvaluationContext &eval_context) const override;
     virtual bool is_reliable_dead_end(
         EvaluationContext &eval_context) const override;
-
-    static OpenList<Entry> *_parse(OptionParser &p);
 };
 
-template<class Entry>
-ParetoOpenList<Entry>::ParetoOpenList(const Options &opts)
+template<class Entry, class Skyline>
+ParetoOpenList<Entry, Skyline>::ParetoOpenList(const Options &opts)
     : OpenList<Entry>(opts.get<bool>("pref_only")),
       rng(utils::parse_rng_from_options(opts)),
       state_uniform_selection(opts.get<bool>("state_uniform_selection")),
       evaluators(opts.get_list<shared_ptr<Evaluator>>("evals")) {
 }
 
-template<class Entry>
-bool ParetoOpenList<Entry>::dominates(
-    const KeyType &v1, const KeyType &v2) const {
-    assert(v1.size() == v2.size());
-    bool are_different = false;
-    for (size_t i = 0; i < v1.size(); ++i) {
-        if (v1[i] > v2[i])
-            return false;
-        else if (v1[i] < v2[i])
-            are_different = true;
-    }
-    return are_different;
-}
-
-template<class Entry>
-bool ParetoOpenList<Entry>::is_nondominated(
-    const KeyType &vec, KeySet &domination_candidates) const {
-    for (const KeyType &candidate : domination_candidates)
-        if (dominates(candidate, vec))
-            return false;
-    return true;
-}
-
-template<class Entry>
-void ParetoOpenList<Entry>::remove_key(const KeyType &key) {
-    /*
-      We must copy the key because it is likely to live inside the
-      data structures from which we remove it here and hence becomes
-      invalid at that point.
-    */
-    vector<int> copied_key(key);
-    nondominated.erase(copied_key);
-    buckets.erase(copied_key);
-    KeySet candidates;
-    for (const auto &bucket_pair : buckets) {
-        const KeyType &bucket_key = bucket_pair.first;
-        /*
-          If the estimate vector of the bucket is not already in the
-          set of nondominated estimate vectors and the vector was
-          previously dominated by key and the estimate vector is not
-          dominated by any vector from the set of nondominated
-          vectors, we add it to the candidates.
-        */
-        if (!nondominated.count(bucket_key) &&
-            dominates(copied_key, bucket_key) &&
-            is_nondominated(bucket_key, nondominated))
-            candidates.insert(bucket_key);
-    }
-    for (const KeyType &candidate : candidates)
-        if (is_nondominated(candidate, candidates))
-            nondominated.insert(candidate);
-}
-
-template<class Entry>
-void ParetoOpenList<Entry>::do_insertion(
+template<class Entry, class Skyline>
+void ParetoOpenList<Entry, Skyline>::do_insertion(
     EvaluationContext &eval_context, const Entry &entry) {
-    vector<int> key;
-    key.reserve(evaluators.size());
-    for (const shared_ptr<Evaluator> &evaluator : evaluators)
-        key.push_back(eval_context.get_evaluator_value_or_infinity(evaluator.get()));
+    Key key = Skyline::create_key(evaluators.size());
+    for (size_t i = 0; i < evaluators.size(); ++i)
+        key[i] = eval_context.get_evaluator_value_or_infinity(evaluators[i].get());
 
     Bucket &bucket = buckets[key];
-    bool newkey = bucket.empty();
+    if (bucket.empty())
+        skyline.insert(key);
     bucket.push_back(entry);
-
-    if (newkey && is_nondominated(key, nondominated)) {
-        /*
-          Delete previously nondominated keys that are now dominated
-          by key.
-
-          Note: this requires that nondominated is a "normal"
-          set (no hash set) because then iterators are not
-          invalidated by erase(it).
-        */
-        auto it = nondominated.begin();
-        while (it != nondominated.end()) {
-            if (dominates(key, *it)) {
-                auto tmp_it = it;
-                ++it;
-                nondominated.erase(tmp_it);
-            } else {
-                ++it;
-            }
-        }
-        // Insert new key.
-        nondominated.insert(key);
-    }
 }
 
-template<class Entry>
-Entry ParetoOpenList<Entry>::remove_min() {
-    typename KeySet::iterator selected = nondominated.begin();
+template<class Entry, class Skyline>
+Entry ParetoOpenList<Entry, Skyline>::remove_min() {
+    const typename Skyline::KeySet &nondominated = skyline.get_nondominated();
+    auto selected = nondominated.begin();
     int seen = 0;
-    for (typename KeySet::iterator it = nondominated.begin();
-         it != nondominated.end(); ++it) {
+    for (auto it = nondominated.begin(); it != nondominated.end(); ++it) {
         int numerator;
         if (state_uniform_selection)
             numerator = it->size();
@@ -171,34 +255,50 @@ Entry ParetoOpenList<Entry>::remove_min() {
         if ((*rng)(seen) < numerator)
             selected = it;
     }
-    Bucket &bucket = buckets[*selected];
+    auto bucket_it = buckets.find(*selected);
+    assert(bucket_it != buckets.end());
+    Bucket &bucket = bucket_it->second;
     Entry result = bucket.front();
     bucket.pop_front();
-    if (bucket.empty())
-        remove_key(*selected);
+    if (bucket.empty()) {
+        /*
+          We must copy the key because erasing it from the skyline
+          invalidates selected.
+        */
+        Key key = *selected;
+        buckets.erase(bucket_it);
+        skyline.erase(key);
+    }
     return result;
 }
 
-template<class Entry>
-bool ParetoOpenList<Entry>::empty() const {
-    return nondominated.empty();
+template<class Entry, class Skyline>
+bool ParetoOpenList<Entry, Skyline>::empty() const {
+    return skyline.get_nondominated().empty();
 }
 
-template<class Entry>
-void ParetoOpenList<Entry>::clear() {
+template<class Entry, class Skyline>
+void ParetoOpenList<Entry, Skyline>::clear() {
     buckets.clear();
-    nondominated.clear();
+    skyline.clear();
 }
 
-template<class Entry>
-void ParetoOpenList<Entry>::get_path_dependent_evaluators(
+template<class Entry, class Skyline>
+void ParetoOpenList<Entry, Skyline>::get_path_dependent_evaluators(
     set<Evaluator *> &evals) {
     for (const shared_ptr<Evaluator> &evaluator : evaluators)
         evaluator->get_path_dependent_evaluators(evals);
 }
 
-template<class Entry>
-bool ParetoOpenList<Entry>::is_dead_end(
+template<class Entry, class Skyline>
+void ParetoOpenList<Entry, Skyline>::compute_results(
+    const vector<EvaluationContext *> &eval_contexts) {
+    for (const shared_ptr<Evaluator> &evaluator : evaluators)
+        evaluator->compute_results(eval_contexts);
+}
+
+template<class Entry, class Skyline>
+bool ParetoOpenList<Entry, Skyline>::is_dead_end(
     EvaluationContext &eval_context) const {
     // TODO: Document this behaviour.
     // If one safe heuristic detects a dead end, return true.
@@ -211,8 +311,8 @@ bool ParetoOpenList<Entry>::is_dead_end(
     return true;
 }
 
-template<class Entry>
-bool ParetoOpenList<Entry>::is_reliable_dead_end(
+template<class Entry, class Skyline>
+bool ParetoOpenList<Entry, Skyline>::is_reliable_dead_end(
     EvaluationContext &eval_context) const {
     for (const shared_ptr<Evaluator> &evaluator : evaluators)
         if (eval_context.is_evaluator_value_infinite(evaluator.get()) &&
@@ -221,6 +321,17 @@ bool ParetoOpenList<Entry>::is_reliable_dead_end(
     return false;
 }
 
+template<class Entry>
+static unique_ptr<OpenList<Entry>> create_pareto_open_list(
+    const Options &options) {
+    if (options.get_list<shared_ptr<Evaluator>>("evals").size() == 2)
+        return utils::make_unique_ptr<
+            ParetoOpenList<Entry, TwoDimensionalSkyline>>(options);
+    else
+        return utils::make_unique_ptr<
+            ParetoOpenList<Entry, GeneralSkyline>>(options);
+}
+
 ParetoOpenListFactory::ParetoOpenListFactory(
     const Options &options)
     : options(options) {
@@ -228,12 +339,12 @@ ParetoOpenListFactory::ParetoOpenListFactory(
 
 unique_ptr<StateOpenList>
 ParetoOpenListFactory::create_state_open_list() {
-    return utils::make_unique_ptr<ParetoOpenList<StateOpenListEntry>>(options);
+    return create_pareto_open_list<StateOpenListEntry>(options);
 }
 
 unique_ptr<EdgeOpenList>
 ParetoOpenListFactory::create_edge_open_list() {
-    return utils::make_unique_ptr<ParetoOpenList<EdgeOpenListEntry>>(options);
+    return create_pareto_open_list<EdgeOpenListEntry>(options);
 }
 
 static shared_ptr<OpenListFactory> _parse(OptionParser &parser) {
@@ -44,6 +44,8 @@ public:
     virtual bool is_reliable_dead_end(
         EvaluationContext &eval_context) const override;
     virtual void get_path_dependent_evaluators(set<Evaluator *> &evals) override;
+    virtual void compute_results(
+        const vector<EvaluationContext *> &eval_contexts) override;
 };
 
 template<class Entry>
@@ -135,6 +137,14 @@ void TypeBasedOpenList<Entry>::get_path_dependent_evaluators(
     }
 }
 
+template<class Entry>
+void TypeBasedOpenList<Entry>::compute_results(
+    const vector<EvaluationContext *> &eval_contexts) {
+    for (const shared_ptr<Evaluator> &evaluator : evaluators) {
+        evaluator->compute_results(eval_contexts);
+    }
+}
+
 TypeBasedOpenListFactory::TypeBasedOpenListFactory(
     const Options &options)
     : options(options) {
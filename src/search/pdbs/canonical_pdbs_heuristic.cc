@@ -1,6 +1,7 @@
 #include "canonical_pdbs_heuristic.h"
 
 #include "dominance_pruning.h"
+#include "pattern_database.h"
 #include "pattern_generator.h"
 #include "utils.h"
 
@@ -35,6 +36,10 @@ CanonicalPDBs get_canonical_pdbs_from_options(
     shared_ptr<PDBCollection> pdbs = pattern_collection_info.get_pdbs();
     shared_ptr<vector<PatternClique>> pattern_cliques =
         pattern_collection_info.get_pattern_cliques();
+    if (opts.get<bool>("compress")) {
+        for (const shared_ptr<PatternDatabase> &pdb : *pdbs)
+            pdb->compress();
+    }
 
     double max_time_dominance_pruning = opts.get<double>("max_time_dominance_pruning");
     if (max_time_dominance_pruning > 0.0) {
@@ -86,6 +91,12 @@ void add_canonical_pdbs_options_to_parser(options::OptionParser &parser) {
         "value because there are dominating subsets in the collection.",
         "infinity",
         Bounds("0.0", "infinity"));
+    parser.add_option<bool>(
+        "compress",
+        "store the PDB distances bit-packed with the minimal number of bits "
+        "needed for the largest finite distance. This reduces the memory "
+        "usage considerably at a small cost per lookup.",
+        "false");
 }
 
 static shared_ptr<Heuristic> _parse(OptionParser &parser) {
@@ -0,0 +1,61 @@
+#include "packed_distances.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace pdbs {
+static const int INF = numeric_limits<int>::max();
+
+static int compute_bits_per_entry(const vector<int> &distances) {
+    int max_finite_distance = 0;
+    for (int distance : distances) {
+        if (distance != INF)
+            max_finite_distance = max(max_finite_distance, distance);
+    }
+    // Reserve the largest representable value for dead ends.
+    int bits = 1;
+    while ((uint64_t(1) << bits) - 1 <= static_cast<uint64_t>(max_finite_distance))
+        ++bits;
+    return bits;
+}
+
+PackedDistances::PackedDistances(const vector<int> &distances)
+    : num_entries(distances.size()),
+      bits_per_entry(compute_bits_per_entry(distances)),
+      entry_mask((uint64_t(1) << bits_per_entry) - 1),
+      owned_words(get_num_words(num_entries, bits_per_entry), 0),
+      words(owned_words.data()) {
+    for (int index = 0; index < num_entries; ++index) {
+        uint64_t entry = distances[index] == INF ? entry_mask : distances[index];
+        uint64_t bit_index = static_cast<uint64_t>(index) * bits_per_entry;
+        uint64_t word_index = bit_index / 64;
+        int shift = bit_index % 64;
+        owned_words[word_index] |= entry << shift;
+        if (shift + bits_per_entry > 64) {
+            owned_words[word_index + 1] |= entry >> (64 - shift);
+        }
+        assert(get(index) == distances[index]);
+    }
+}
+
+PackedDistances::PackedDistances(
+    unique_ptr<utils::MappedFile> file, size_t offset,
+    int num_entries, int bits_per_entry)
+    : num_entries(num_entries),
+      bits_per_entry(bits_per_entry),
+      entry_mask((uint64_t(1) << bits_per_entry) - 1),
+      file(move(file)),
+      words(reinterpret_cast<const uint64_t *>(this->file->get_data() + offset)) {
+    assert(bits_per_entry >= 1 && bits_per_entry <= 32);
+    assert(offset % sizeof(uint64_t) == 0);
+    assert(this->file->get_size() >=
+           offset + get_num_words(num_entries, bits_per_entry) * sizeof(uint64_t));
+}
+
+size_t PackedDistances::get_num_words(int num_entries, int bits_per_entry) {
+    uint64_t num_bits = static_cast<uint64_t>(num_entries) * bits_per_entry;
+    // One padding word for entries that cross the last word boundary.
+    return (num_bits + 63) / 64 + 1;
+}
+}
@@ -0,0 +1,79 @@
+#ifndef PDBS_PACKED_DISTANCES_H
+#define PDBS_PACKED_DISTANCES_H
+
+#include "../utils/mapped_file.h"
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace pdbs {
+/*
+  Bit-packed table of PDB distances. Every entry uses the smallest number
+  of bits that can represent all finite distances and one additional value
+  for dead ends (all bits set). Entries may cross the boundary between two
+  words. The table stores one padding word, so reading the second word of
+  an entry never goes out of bounds.
+
+  The words are either owned by the table or live in a memory-mapped file
+  (see the disk cache in pattern_database.cc).
+*/
+class PackedDistances {
+    int num_entries;
+    int bits_per_entry;
+    uint64_t entry_mask;
+    std::vector<uint64_t> owned_words;
+    std::unique_ptr<utils::MappedFile> file;
+    const uint64_t *words;
+
+public:
+    // Dead ends are represented by numeric_limits<int>::max().
+    explicit PackedDistances(const std::vector<int> &distances);
+    /*
+      Use the words stored in the given file, starting at the given byte
+      offset, which must be a multiple of 8. The caller has to make sure
+      that the file contains get_num_words(num_entries, bits_per_entry)
+      words at this offset.
+    */
+    PackedDistances(
+        std::unique_ptr<utils::MappedFile> file, size_t offset,
+        int num_entries, int bits_per_entry);
+
+    static size_t get_num_words(int num_entries, int bits_per_entry);
+
+    int get(int index) const {
+        assert(index >= 0 && index < num_entries);
+        uint64_t bit_index = static_cast<uint64_t>(index) * bits_per_entry;
+        uint64_t word_index = bit_index / 64;
+        int shift = bit_index % 64;
+        uint64_t entry = words[word_index] >> shift;
+        if (shift + bits_per_entry > 64) {
+            entry |= words[word_index + 1] << (64 - shift);
+        }
+        entry &= entry_mask;
+        if (entry == entry_mask)
+            return std::numeric_limits<int>::max();
+        return static_cast<int>(entry);
+    }
+
+    int get_num_entries() const {
+        return num_entries;
+    }
+
+    int get_bits_per_entry() const {
+        return bits_per_entry;
+    }
+
+    const uint64_t *get_words() const {
+        return words;
+    }
+
+    size_t get_num_words() const {
+        return get_num_words(num_entries, bits_per_entry);
+    }
+};
+}
+
+#endif
@@ -14,6 +14,7 @@
 #include "../utils/math.h"
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
+#include "../utils/thread_pool.h"
 #include "../utils/timer.h"
 
 #include <algorithm>
@@ -32,6 +33,7 @@ PatternCollectionGeneratorGenetic::PatternCollectionGeneratorGenetic(
       num_episodes(opts.get<int>("num_episodes")),
       mutation_probability(opts.get<double>("mutation_probability")),
       disjoint_patterns(opts.get<bool>("disjoint")),
+      max_parallel_size(opts.get<int>("max_parallel_size")),
       rng(utils::parse_rng_from_options(opts)) {
 }
 
@@ -161,10 +163,15 @@ bool PatternCollectionGeneratorGenetic::mark_used_variables(
 
 void PatternCollectionGeneratorGenetic::evaluate(vector<double> &fitness_values) {
     TaskProxy task_proxy(*task);
+    int num_pattern_collections = pattern_collections.size();
+    // Invalid pattern collections are represented by nullptr.
+    vector<shared_ptr<PatternCollection>> valid_pattern_collections;
+    vector<int> sizes;
+    valid_pattern_collections.reserve(num_pattern_collections);
+    sizes.reserve(num_pattern_collections);
     for (const auto &collection : pattern_collections) {
         //utils::g_log << "evaluate pattern collection " << (i + 1) << " of "
         //     << pattern_collections.size() << endl;
-        double fitness = 0;
         bool pattern_valid = true;
         vector<bool> variables_used(task_proxy.get_variables().size(), false);
         shared_ptr<PatternCollection> pattern_collection = make_shared<PatternCollection>();
@@ -189,20 +196,41 @@ void PatternCollectionGeneratorGenetic::evaluate(vector<double> &fitness_values)
             remove_irrelevant_variables(pattern);
             pattern_collection->push_back(pattern);
         }
-        if (!pattern_valid) {
+        if (pattern_valid) {
+            valid_pattern_collections.push_back(pattern_collection);
+            sizes.push_back(compute_total_pdb_size(task_proxy, *pattern_collection));
+        } else {
+            valid_pattern_collections.push_back(nullptr);
+            sizes.push_back(0);
+        }
+    }
+
+    /* Generate the pattern collection heuristics and get their fitness
+       values. The collections are independent, so we evaluate them in
+       parallel. */
+    vector<double> collection_fitness_values(num_pattern_collections);
+    utils::run_with_size_budget(
+        sizes, max_parallel_size, [&](int i, int) {
+            if (valid_pattern_collections[i]) {
+                ZeroOnePDBs zero_one_pdbs(task_proxy, *valid_pattern_collections[i]);
+                collection_fitness_values[i] =
+                    zero_one_pdbs.compute_approx_mean_finite_h();
+            }
+        });
+
+    for (int i = 0; i < num_pattern_collections; ++i) {
+        double fitness = 0;
+        if (!valid_pattern_collections[i]) {
             /* Set fitness to a very small value to cover cases in which all
                patterns are invalid. */
             fitness = 0.001;
         } else {
-            /* Generate the pattern collection heuristic and get its fitness
-               value. */
-            ZeroOnePDBs zero_one_pdbs(task_proxy, *pattern_collection);
-            fitness = zero_one_pdbs.compute_approx_mean_finite_h();
+            fitness = collection_fitness_values[i];
             // Update the best heuristic found so far.
             if (fitness > best_fitness) {
                 best_fitness = fitness;
                 utils::g_log << "best_fitness = " << best_fitness << endl;
-                best_patterns = pattern_collection;
+                best_patterns = valid_pattern_collections[i];
             }
         }
         fitness_values.push_back(fitness);
@@ -371,6 +399,14 @@ static shared_ptr<PatternCollectionGenerator> _parse(OptionParser &parser) {
         "consider a pattern collection invalid (giving it very low "
         "fitness) if its patterns are not disjoint",
         "false");
+    parser.add_option<int>(
+        "max_parallel_size",
+        "maximal total number of states of the pattern collections that "
+        "are evaluated in parallel if the planner uses several threads "
+        "(see --threads). A single pattern collection may exceed this "
+        "limit.",
+        "20000000",
+        Bounds("1", "infinity"));
 
     utils::add_rng_options(parser);
 
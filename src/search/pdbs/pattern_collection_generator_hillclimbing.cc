@@ -20,6 +20,7 @@
 #include "../utils/memory.h"
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
+#include "../utils/thread_pool.h"
 #include "../utils/timer.h"
 
 #include <algorithm>
@@ -131,7 +132,7 @@ int PatternCollectionGeneratorHillclimbing::generate_candidate_pdbs(
     PDBCollection &candidate_pdbs) {
     const Pattern &pattern = pdb.get_pattern();
     int pdb_size = pdb.get_size();
-    int max_pdb_size = 0;
+    PatternCollection new_patterns;
     for (int pattern_var : pattern) {
         assert(utils::in_bounds(pattern_var, relevant_neighbours));
         const vector<int> &connected_vars = relevant_neighbours[pattern_var];
@@ -158,16 +159,27 @@ int PatternCollectionGeneratorHillclimbing::generate_candidate_pdbs(
                       surpass the size limit.
                     */
                     generated_patterns.insert(new_pattern);
-                    candidate_pdbs.push_back(
-                        make_shared<PatternDatabase>(task_proxy, new_pattern));
-                    max_pdb_size = max(max_pdb_size,
-                                       candidate_pdbs.back()->get_size());
+                    new_patterns.push_back(move(new_pattern));
                 }
             } else {
                 ++num_rejected;
             }
         }
     }
+
+    /*
+      The candidate PDBs are independent of each other, so we compute them
+      in parallel. Candidates that exceed collection_max_size on their own
+      will never be added to the collection, so this limit is also a
+      natural budget for the PDBs under construction.
+    */
+    PDBCollection new_pdbs =
+        compute_pdbs(task_proxy, new_patterns, collection_max_size);
+    int max_pdb_size = 0;
+    for (shared_ptr<PatternDatabase> &new_pdb : new_pdbs) {
+        max_pdb_size = max(max_pdb_size, new_pdb->get_size());
+        candidate_pdbs.push_back(move(new_pdb));
+    }
     return max_pdb_size;
 }
 
@@ -203,51 +215,64 @@ pair<int, int> PatternCollectionGeneratorHillclimbing::find_best_improving_pdb(
     */
     int improvement = 0;
     int best_pdb_index = -1;
+    int num_candidates = candidate_pdbs.size();
 
-    // Iterate over all candidates and search for the best improving pattern/pdb
-    for (size_t i = 0; i < candidate_pdbs.size(); ++i) {
-        if (hill_climbing_timer->is_expired())
-            throw HillClimbingTimeout();
-
+    /*
+      If a candidate's size added to the current collection's size exceeds
+      the maximum collection size, then forget the pdb.
+    */
+    for (int i = 0; i < num_candidates; ++i) {
         const shared_ptr<PatternDatabase> &pdb = candidate_pdbs[i];
-        if (!pdb) {
-            /* candidate pattern is too large or has already been added to
-               the canonical heuristic. */
-            continue;
-        }
-        /*
-          If a candidate's size added to the current collection's size exceeds
-          the maximum collection size, then forget the pdb.
-        */
-        int combined_size = current_pdbs->get_size() + pdb->get_size();
-        if (combined_size > collection_max_size) {
+        /* Candidates that are null are too large or have already been added
+           to the canonical heuristic. */
+        if (pdb && current_pdbs->get_size() + pdb->get_size() > collection_max_size)
             candidate_pdbs[i] = nullptr;
-            continue;
-        }
+    }
 
-        /*
-          Calculate the "counting approximation" for all sample states: count
-          the number of samples for which the current pattern collection
-          heuristic would be improved if the new pattern was included into it.
-        */
-        /*
-          TODO: The original implementation by Haslum et al. uses m/t as a
-          statistical confidence interval to stop the A*-search (which they use,
-          see above) earlier.
-        */
-        int count = 0;
-        vector<PatternClique> pattern_cliques =
-            current_pdbs->get_pattern_cliques(pdb->get_pattern());
-        for (int sample_id = 0; sample_id < num_samples; ++sample_id) {
-            const State &sample = samples[sample_id];
-            assert(utils::in_bounds(sample_id, samples_h_values));
-            int h_collection = samples_h_values[sample_id];
-            if (is_heuristic_improved(
-                    *pdb, sample, h_collection,
-                    *current_pdbs->get_pattern_databases(), pattern_cliques)) {
-                ++count;
+    /*
+      Calculate the "counting approximation" for all candidates and sample
+      states: count the number of samples for which the current pattern
+      collection heuristic would be improved if the new pattern was
+      included into it. The candidates are evaluated in parallel. Jobs
+      that see the expired timer set their count to -1, and we abort once
+      all jobs are done.
+    */
+    /*
+      TODO: The original implementation by Haslum et al. uses m/t as a
+      statistical confidence interval to stop the A*-search (which they use,
+      see above) earlier.
+    */
+    vector<int> counts(num_candidates, 0);
+    utils::run_in_parallel(
+        num_candidates, [&](int i, int) {
+            const shared_ptr<PatternDatabase> &pdb = candidate_pdbs[i];
+            if (!pdb)
+                return;
+            if (hill_climbing_timer->is_expired()) {
+                counts[i] = -1;
+                return;
             }
-        }
+            vector<PatternClique> pattern_cliques =
+                current_pdbs->get_pattern_cliques(pdb->get_pattern());
+            int count = 0;
+            for (int sample_id = 0; sample_id < num_samples; ++sample_id) {
+                const State &sample = samples[sample_id];
+                assert(utils::in_bounds(sample_id, samples_h_values));
+                int h_collection = samples_h_values[sample_id];
+                if (is_heuristic_improved(
+                        *pdb, sample, h_collection,
+                        *current_pdbs->get_pattern_databases(), pattern_cliques)) {
+                    ++count;
+                }
+            }
+            counts[i] = count;
+        });
+
+    // Iterate over all candidates and search for the best improving pattern/pdb
+    for (int i = 0; i < num_candidates; ++i) {
+        int count = counts[i];
+        if (count == -1)
+            throw HillClimbingTimeout();
         if (count > improvement) {
             improvement = count;
             best_pdb_index = i;
@@ -443,7 +468,10 @@ void add_hillclimbing_options(OptionParser &parser) {
         Bounds("1", "infinity"));
     parser.add_option<int>(
         "collection_max_size",
-        "maximal number of states in the pattern collection",
+        "maximal number of states in the pattern collection. If the "
+        "planner uses several threads (see --threads), candidate PDBs are "
+        "computed in parallel as long as their total number of states is "
+        "within this limit.",
         "20000000",
         Bounds("1", "infinity"));
     parser.add_option<int>(
@@ -618,6 +646,7 @@ static shared_ptr<Heuristic> _parse_ipdb(OptionParser &parser) {
         "patterns", pgh);
     heuristic_opts.set<double>(
         "max_time_dominance_pruning", opts.get<double>("max_time_dominance_pruning"));
+    heuristic_opts.set<bool>("compress", opts.get<bool>("compress"));
 
     return make_shared<CanonicalPDBsHeuristic>(heuristic_opts);
 }
@@ -2,6 +2,7 @@
 
 #include "pattern_database.h"
 #include "pattern_cliques.h"
+#include "utils.h"
 #include "validation.h"
 
 #include "../utils/logging.h"
@@ -9,6 +10,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <limits>
 #include <unordered_set>
 #include <utility>
 
@@ -58,13 +60,15 @@ void PatternCollectionInformation::create_pdbs_if_missing() {
     if (!pdbs) {
         utils::Timer timer;
         utils::g_log << "Computing PDBs for pattern collection..." << endl;
-        pdbs = make_shared<PDBCollection>();
-        for (const Pattern &pattern : *patterns) {
-            shared_ptr<PatternDatabase> pdb =
-                make_shared<PatternDatabase>(task_proxy, pattern);
-            pdbs->push_back(pdb);
-        }
+        /*
+          All PDBs are kept, so limiting the number of PDBs that are
+          computed in parallel would not lower the peak memory usage.
+        */
+        pdbs = make_shared<PDBCollection>(
+            compute_pdbs(task_proxy, *patterns, numeric_limits<int>::max()));
         utils::g_log << "Done computing PDBs for pattern collection: " << timer << endl;
+        dump_pdb_construction_throughput(
+            compute_total_pdb_size(task_proxy, *patterns), timer());
     }
 }
 
@@ -1,25 +1,53 @@
 #include "pattern_database.h"
 
 #include "match_tree.h"
+#include "packed_distances.h"
+#include "utils.h"
+
+#include "../disk_cache.h"
 
-#include "../algorithms/priority_queues.h"
 #include "../task_utils/task_properties.h"
 #include "../utils/collections.h"
+#include "../utils/hash.h"
 #include "../utils/logging.h"
 #include "../utils/math.h"
+#include "../utils/memory.h"
+#include "../utils/thread_pool.h"
 #include "../utils/timer.h"
 
 #include <algorithm>
 #include <cassert>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <limits>
+#include <map>
 #include <string>
 #include <vector>
 
 using namespace std;
 
 namespace pdbs {
+/*
+  Layout of PDB cache files: the magic bytes, the format version, a
+  byte-order mark, the cache key, the number of abstract states and the
+  number of bits per entry, followed by the words of the packed distances.
+  The header size is a multiple of 8, so the words can be used directly
+  from the memory-mapped file.
+*/
+static const char CACHE_MAGIC[8] = {'\x89', 'F', 'D', 'P', 'D', 'B', '\n', '\0'};
+static const uint32_t CACHE_FORMAT_VERSION = 1;
+static const uint32_t CACHE_BYTE_ORDER_MARK = 0x01020304;
+static const size_t CACHE_HEADER_SIZE = 32;
+
+/*
+  Smaller layers are regressed sequentially. Larger layers are regressed
+  in rounds of at most MAX_STATES_PER_REGRESSION_JOB states per job, which
+  bounds the memory for the buffered regression steps.
+*/
+static const int MIN_STATES_PER_REGRESSION_JOB = 4096;
+static const int MAX_STATES_PER_REGRESSION_JOB = 16384;
+
 AbstractOperator::AbstractOperator(const vector<FactPair> &prev_pairs,
                                    const vector<FactPair> &pre_pairs,
                                    const vector<FactPair> &eff_pairs,
@@ -93,9 +121,25 @@ PatternDatabase::PatternDatabase(
             utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
         }
     }
-    create_pdb(task_proxy, operator_costs);
-    if (dump)
+
+    uint64_t cache_key = 0;
+    string cache_file;
+    if (disk_cache::cache_is_enabled()) {
+        cache_key = compute_cache_key(task_proxy, operator_costs);
+        cache_file = disk_cache::get_cache_file("pdb", cache_key);
+    }
+    if (cache_file.empty() || !load_from_cache_file(cache_file, cache_key)) {
+        create_pdb(task_proxy, operator_costs);
+        if (!cache_file.empty())
+            write_to_cache_file(cache_file, cache_key);
+    }
+    if (dump) {
         utils::g_log << "PDB construction time: " << timer << endl;
+        dump_pdb_construction_throughput(num_states, timer());
+    }
+}
+
+PatternDatabase::~PatternDatabase() {
 }
 
 void PatternDatabase::multiply_out(
@@ -226,43 +270,257 @@ void PatternDatabase::create_pdb(
     }
 
     distances.reserve(num_states);
-    // first implicit entry: priority, second entry: index for an abstract state
-    priority_queues::AdaptiveQueue<int> pq;
-
-    // initialize queue
+    vector<int> goal_states;
     for (int state_index = 0; state_index < num_states; ++state_index) {
         if (is_goal_state(state_index, abstract_goals, variables)) {
-            pq.push(0, state_index);
+            goal_states.push_back(state_index);
             distances.push_back(0);
         } else {
             distances.push_back(numeric_limits<int>::max());
         }
     }
 
-    // Dijkstra loop
-    while (!pq.empty()) {
-        pair<int, int> node = pq.pop();
-        int distance = node.first;
-        int state_index = node.second;
-        if (distance > distances[state_index]) {
-            continue;
-        }
+    compute_distances(match_tree, operators, move(goal_states));
+}
 
-        // regress abstract_state
-        vector<int> applicable_operator_ids;
-        match_tree.get_applicable_operator_ids(state_index, applicable_operator_ids);
-        for (int op_id : applicable_operator_ids) {
-            const AbstractOperator &op = operators[op_id];
-            int predecessor = state_index + op.get_hash_effect();
-            int alternative_cost = distances[state_index] + op.get_cost();
+void PatternDatabase::compute_distances(
+    const MatchTree &match_tree, const vector<AbstractOperator> &operators,
+    vector<int> &&goal_states) {
+    /*
+      Group the operators by cost, so that we can look up the layer for
+      the predecessors reached by an operator before regressing a layer.
+    */
+    vector<int> costs;
+    costs.reserve(operators.size());
+    for (const AbstractOperator &op : operators) {
+        costs.push_back(op.get_cost());
+    }
+    utils::sort_unique(costs);
+    vector<int> cost_indices;
+    cost_indices.reserve(operators.size());
+    for (const AbstractOperator &op : operators) {
+        cost_indices.push_back(
+            lower_bound(costs.begin(), costs.end(), op.get_cost()) - costs.begin());
+    }
+
+    /*
+      layers[d] contains all states whose distance has been set to d. A
+      state can be contained in several layers if its distance decreases
+      later; we skip it in all layers but the one of its final distance.
+      For tasks with a single operator cost, there are at most two layers
+      at a time and the search is a breadth-first search.
+    */
+    map<int, vector<int>> layers;
+    layers[0] = move(goal_states);
+    vector<vector<int> *> successor_layers(costs.size());
+
+    int num_threads = utils::get_available_num_threads();
+    // Scratch data for regressing states, one entry per worker.
+    vector<vector<int>> applicable_operator_ids(num_threads);
+    // Predecessors and the operators reaching them, one entry per job.
+    vector<vector<pair<int, int>>> regression_steps(num_threads);
+
+    /*
+      Add the predecessors of the given state that might get a lower
+      distance to steps. This only reads the distances, so it can run in
+      parallel for the states of a layer.
+    */
+    auto regress = [&](int state_index, int distance, vector<int> &operator_ids,
+                       vector<pair<int, int>> &steps) {
+            operator_ids.clear();
+            match_tree.get_applicable_operator_ids(state_index, operator_ids);
+            for (int op_id : operator_ids) {
+                const AbstractOperator &op = operators[op_id];
+                int predecessor = state_index + op.get_hash_effect();
+                if (distance + op.get_cost() < distances[predecessor])
+                    steps.emplace_back(predecessor, op_id);
+            }
+        };
+    auto update_distance = [&](int predecessor, int op_id, int distance) {
+            int alternative_cost = distance + operators[op_id].get_cost();
             if (alternative_cost < distances[predecessor]) {
                 distances[predecessor] = alternative_cost;
-                pq.push(alternative_cost, predecessor);
+                successor_layers[cost_indices[op_id]]->push_back(predecessor);
+            }
+        };
+
+    while (!layers.empty()) {
+        auto layer_it = layers.begin();
+        int distance = layer_it->first;
+        vector<int> &layer = layer_it->second;
+        if (layer.empty()) {
+            // Do not create successor layers for empty layers.
+            layers.erase(layer_it);
+            continue;
+        }
+        /*
+          Regressing the states in the order of their indices makes the
+          accesses to the distances of their predecessors mostly sequential.
+        */
+        sort(layer.begin(), layer.end());
+        // Operators with cost 0 add states to the current layer.
+        for (size_t i = 0; i < costs.size(); ++i) {
+            successor_layers[i] = costs[i] == 0 ? &layer : &layers[distance + costs[i]];
+        }
+
+        size_t next = 0;
+        while (next < layer.size()) {
+            int layer_size = layer.size() - next;
+            int num_jobs = min(num_threads, layer_size / MIN_STATES_PER_REGRESSION_JOB);
+            if (num_jobs <= 1) {
+                vector<int> &operator_ids = applicable_operator_ids[0];
+                for (; next < layer.size(); ++next) {
+                    int state_index = layer[next];
+                    if (distances[state_index] < distance)
+                        continue;
+                    operator_ids.clear();
+                    match_tree.get_applicable_operator_ids(state_index, operator_ids);
+                    for (int op_id : operator_ids) {
+                        int predecessor = state_index + operators[op_id].get_hash_effect();
+                        update_distance(predecessor, op_id, distance);
+                    }
+                }
+            } else {
+                /*
+                  The jobs only read the distances. The distances of the
+                  predecessors are updated afterwards in the order of the
+                  jobs, so the layers do not depend on the thread timing.
+                */
+                int round_size = min(
+                    layer_size, num_jobs * MAX_STATES_PER_REGRESSION_JOB);
+                utils::run_in_parallel(num_jobs, [&](int job, int worker) {
+                        vector<pair<int, int>> &steps = regression_steps[job];
+                        steps.clear();
+                        size_t begin = next + int64_t(round_size) * job / num_jobs;
+                        size_t end = next + int64_t(round_size) * (job + 1) / num_jobs;
+                        for (size_t i = begin; i < end; ++i) {
+                            int state_index = layer[i];
+                            if (distances[state_index] < distance)
+                                continue;
+                            regress(state_index, distance,
+                                    applicable_operator_ids[worker], steps);
+                        }
+                    });
+                next += round_size;
+                for (int job = 0; job < num_jobs; ++job) {
+                    for (const pair<int, int> &step : regression_steps[job])
+                        update_distance(step.first, step.second, distance);
+                }
             }
         }
+        layers.erase(layer_it);
     }
 }
 
+uint64_t PatternDatabase::compute_cache_key(
+    const TaskProxy &task_proxy, const vector<int> &operator_costs) const {
+    /*
+      The distances only depend on the domains of the pattern variables,
+      the operators affecting the pattern (restricted to the pattern) and
+      their costs, and the goals on the pattern variables. Since all
+      variable values are nonnegative, -1 separates the lists.
+    */
+    VariablesProxy variables = task_proxy.get_variables();
+    vector<int> variable_to_index(variables.size(), -1);
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        variable_to_index[pattern[i]] = i;
+    }
+    utils::HashState hash_state;
+    utils::feed(hash_state, CACHE_FORMAT_VERSION);
+    for (int var_id : pattern) {
+        utils::feed(hash_state, variables[var_id].get_domain_size());
+    }
+    for (OperatorProxy op : task_proxy.get_operators()) {
+        if (!is_operator_relevant(op))
+            continue;
+        utils::feed(hash_state, -1);
+        utils::feed(hash_state, operator_costs.empty() ?
+                    op.get_cost() : operator_costs[op.get_id()]);
+        for (FactProxy pre : op.get_preconditions()) {
+            int pattern_var_id = variable_to_index[pre.get_variable().get_id()];
+            if (pattern_var_id != -1) {
+                utils::feed(hash_state, pattern_var_id);
+                utils::feed(hash_state, pre.get_value());
+            }
+        }
+        utils::feed(hash_state, -1);
+        for (EffectProxy eff : op.get_effects()) {
+            FactProxy fact = eff.get_fact();
+            int pattern_var_id = variable_to_index[fact.get_variable().get_id()];
+            if (pattern_var_id != -1) {
+                utils::feed(hash_state, pattern_var_id);
+                utils::feed(hash_state, fact.get_value());
+            }
+        }
+    }
+    utils::feed(hash_state, -1);
+    for (FactProxy goal : task_proxy.get_goals()) {
+        int pattern_var_id = variable_to_index[goal.get_variable().get_id()];
+        if (pattern_var_id != -1) {
+            utils::feed(hash_state, pattern_var_id);
+            utils::feed(hash_state, goal.get_value());
+        }
+    }
+    return hash_state.get_hash64();
+}
+
+template<typename T>
+static T read_header_field(const char *header, size_t &pos) {
+    T value;
+    memcpy(&value, header + pos, sizeof(T));
+    pos += sizeof(T);
+    return value;
+}
+
+bool PatternDatabase::load_from_cache_file(
+    const string &file_name, uint64_t key) {
+    unique_ptr<utils::MappedFile> file =
+        utils::make_unique_ptr<utils::MappedFile>(file_name);
+    if (!file->is_open() || file->get_size() < CACHE_HEADER_SIZE)
+        return false;
+    const char *header = file->get_data();
+    if (memcmp(header, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0)
+        return false;
+    size_t pos = sizeof(CACHE_MAGIC);
+    uint32_t version = read_header_field<uint32_t>(header, pos);
+    uint32_t byte_order_mark = read_header_field<uint32_t>(header, pos);
+    uint64_t file_key = read_header_field<uint64_t>(header, pos);
+    int32_t file_num_states = read_header_field<int32_t>(header, pos);
+    int32_t bits_per_entry = read_header_field<int32_t>(header, pos);
+    assert(pos == CACHE_HEADER_SIZE);
+    if (version != CACHE_FORMAT_VERSION ||
+        byte_order_mark != CACHE_BYTE_ORDER_MARK ||
+        file_key != key || file_num_states != num_states ||
+        bits_per_entry < 1 || bits_per_entry > 32) {
+        return false;
+    }
+    size_t num_words = PackedDistances::get_num_words(num_states, bits_per_entry);
+    if (file->get_size() < CACHE_HEADER_SIZE + num_words * sizeof(uint64_t))
+        return false;
+    packed_distances = utils::make_unique_ptr<PackedDistances>(
+        move(file), CACHE_HEADER_SIZE, num_states, bits_per_entry);
+    return true;
+}
+
+void PatternDatabase::write_to_cache_file(
+    const string &file_name, uint64_t key) const {
+    unique_ptr<PackedDistances> packed_copy;
+    const PackedDistances *packed = packed_distances.get();
+    if (!packed) {
+        packed_copy = utils::make_unique_ptr<PackedDistances>(distances);
+        packed = packed_copy.get();
+    }
+    disk_cache::CacheWriter writer(file_name);
+    writer.write_array(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    writer.write<uint32_t>(CACHE_FORMAT_VERSION);
+    writer.write<uint32_t>(CACHE_BYTE_ORDER_MARK);
+    writer.write<uint64_t>(key);
+    writer.write<int32_t>(num_states);
+    writer.write<int32_t>(packed->get_bits_per_entry());
+    writer.write_array(packed->get_words(), packed->get_num_words());
+    writer.commit();
+}
+
 bool PatternDatabase::is_goal_state(
     int state_index,
     const vector<FactPair> &abstract_goals,
@@ -289,15 +547,27 @@ int PatternDatabase::hash_index(const vector<int> &state) const {
 }
 
 int PatternDatabase::get_value(const vector<int> &state) const {
-    return distances[hash_index(state)];
+    int index = hash_index(state);
+    if (packed_distances)
+        return packed_distances->get(index);
+    return distances[index];
+}
+
+void PatternDatabase::compress() {
+    if (!packed_distances) {
+        packed_distances = utils::make_unique_ptr<PackedDistances>(distances);
+        utils::release_vector_memory(distances);
+    }
 }
 
 double PatternDatabase::compute_mean_finite_h() const {
     double sum = 0;
     int size = 0;
-    for (size_t i = 0; i < distances.size(); ++i) {
-        if (distances[i] != numeric_limits<int>::max()) {
-            sum += distances[i];
+    for (int index = 0; index < num_states; ++index) {
+        int distance = packed_distances ?
+            packed_distances->get(index) : distances[index];
+        if (distance != numeric_limits<int>::max()) {
+            sum += distance;
             ++size;
         }
     }
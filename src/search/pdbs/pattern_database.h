@@ -5,10 +5,16 @@
 
 #include "../task_proxy.h"
 
+#include <cstdint>
+#include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
 namespace pdbs {
+class MatchTree;
+class PackedDistances;
+
 class AbstractOperator {
     /*
       This class represents an abstract operator how it is needed for
@@ -79,8 +85,11 @@ class PatternDatabase {
     /*
       final h-values for abstract-states.
       dead-ends are represented by numeric_limits<int>::max()
+      If the PDB is compressed or loaded from the disk cache, distances is
+      empty and the h-values are stored in packed_distances instead.
     */
     std::vector<int> distances;
+    std::unique_ptr<PackedDistances> packed_distances;
 
     // multipliers for each variable for perfect hash function
     std::vector<int> hash_multipliers;
@@ -124,6 +133,30 @@ class PatternDatabase {
         const TaskProxy &task_proxy,
         const std::vector<int> &operator_costs = std::vector<int>());
 
+    /*
+      Regression search from the goal states that computes the distances
+      layer by layer: all states with the same distance are regressed as a
+      batch, in parallel if the layer is large and threads are available.
+    */
+    void compute_distances(
+        const MatchTree &match_tree,
+        const std::vector<AbstractOperator> &operators,
+        std::vector<int> &&goal_states);
+
+    /*
+      Hash of the abstract planning task induced by the pattern and the
+      given operator costs. It identifies the PDB in the disk cache.
+    */
+    uint64_t compute_cache_key(
+        const TaskProxy &task_proxy,
+        const std::vector<int> &operator_costs) const;
+    /*
+      Try to map the distances from the given cache file. Returns false
+      if the file does not exist or does not match this PDB.
+    */
+    bool load_from_cache_file(const std::string &file_name, uint64_t key);
+    void write_to_cache_file(const std::string &file_name, uint64_t key) const;
+
     /*
       For a given abstract state (given as index), the according values
       for each variable in the state are computed and compared with the
@@ -146,6 +179,8 @@ public:
       Important: It is assumed that the pattern (passed via Options) is
       sorted, contains no duplicates and is small enough so that the
       number of abstract states is below numeric_limits<int>::max()
+      If the disk cache is enabled, the PDB is loaded from the cache if
+      possible and otherwise added to it after its construction.
       Parameters:
        dump:           If set to true, prints the construction time.
        operator_costs: Can specify individual operator costs for each
@@ -157,10 +192,17 @@ public:
         const Pattern &pattern,
         bool dump = false,
         const std::vector<int> &operator_costs = std::vector<int>());
-    ~PatternDatabase() = default;
+    ~PatternDatabase();
 
     int get_value(const std::vector<int> &state) const;
 
+    /*
+      Store the h-values with the minimal number of bits needed for the
+      largest finite h-value instead of one int per abstract state.
+      Lookups become slightly more expensive.
+    */
+    void compress();
+
     // Returns the pattern (i.e. all variables used) of the PDB
     const Pattern &get_pattern() const {
         return pattern;
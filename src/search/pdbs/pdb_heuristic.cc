@@ -6,6 +6,10 @@
 #include "../option_parser.h"
 #include "../plugin.h"
 
+#include "../utils/collections.h"
+
+#include <algorithm>
+#include <cassert>
 #include <limits>
 #include <memory>
 
@@ -17,15 +21,54 @@ shared_ptr<PatternDatabase> get_pdb_from_options(const shared_ptr<AbstractTask>
     shared_ptr<PatternGenerator> pattern_generator =
         opts.get<shared_ptr<PatternGenerator>>("pattern");
     PatternInformation pattern_info = pattern_generator->generate(task);
-    return pattern_info.get_pdb();
+    shared_ptr<PatternDatabase> pdb = pattern_info.get_pdb();
+    if (opts.get<bool>("compress"))
+        pdb->compress();
+    return pdb;
 }
 
 PDBHeuristic::PDBHeuristic(const Options &opts)
     : Heuristic(opts),
-      pdb(get_pdb_from_options(task, opts)) {
+      pdb(get_pdb_from_options(task, opts)),
+      compress(opts.get<bool>("compress")),
+      estimated_costs_task(
+          dynamic_cast<extra_tasks::EstimatedOperatorCostsTask *>(task.get())),
+      pdb_is_outdated(false) {
+    if (estimated_costs_task) {
+        const Pattern &pattern = pdb->get_pattern();
+        for (OperatorProxy op : task_proxy.get_operators()) {
+            bool affects_pattern = false;
+            for (EffectProxy effect : op.get_effects()) {
+                int var_id = effect.get_fact().get_variable().get_id();
+                if (binary_search(pattern.begin(), pattern.end(), var_id)) {
+                    affects_pattern = true;
+                    break;
+                }
+            }
+            operator_affects_pattern.push_back(affects_pattern);
+        }
+        estimated_costs_task->subscribe(this);
+    }
+}
+
+PDBHeuristic::~PDBHeuristic() {
+    if (estimated_costs_task)
+        estimated_costs_task->unsubscribe(this);
+}
+
+void PDBHeuristic::notify_operator_cost_raised(int op_id, int) {
+    assert(utils::in_bounds(op_id, operator_affects_pattern));
+    if (operator_affects_pattern[op_id])
+        pdb_is_outdated = true;
 }
 
 int PDBHeuristic::compute_heuristic(const State &ancestor_state) {
+    if (pdb_is_outdated) {
+        pdb = make_shared<PatternDatabase>(task_proxy, pdb->get_pattern());
+        if (compress)
+            pdb->compress();
+        pdb_is_outdated = false;
+    }
     State state = convert_ancestor_state(ancestor_state);
     int h = pdb->get_value(state.get_unpacked_values());
     if (h == numeric_limits<int>::max())
@@ -47,6 +90,12 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
         "pattern",
         "pattern generation method",
         "greedy()");
+    parser.add_option<bool>(
+        "compress",
+        "store the PDB distances bit-packed with the minimal number of bits "
+        "needed for the largest finite distance. This reduces the memory "
+        "usage considerably at a small cost per lookup.",
+        "false");
     Heuristic::add_options_to_parser(parser);
 
     Options opts = parser.parse();
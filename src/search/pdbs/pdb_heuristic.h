@@ -3,6 +3,10 @@
 
 #include "../heuristic.h"
 
+#include "../tasks/estimated_operator_costs_task.h"
+
+#include <vector>
+
 namespace options {
 class Options;
 }
@@ -11,8 +15,21 @@ namespace pdbs {
 class PatternDatabase;
 
 // Implements a heuristic for a single PDB.
-class PDBHeuristic : public Heuristic {
+class PDBHeuristic
+    : public Heuristic, public extra_tasks::OperatorCostsListener {
     std::shared_ptr<PatternDatabase> pdb;
+    const bool compress;
+
+    /*
+      Set if the heuristic is computed on the estimated-costs task. Raising
+      the cost of an operator that affects the pattern marks the PDB as
+      outdated and it is recomputed before the next evaluation.
+    */
+    extra_tasks::EstimatedOperatorCostsTask *estimated_costs_task;
+    std::vector<bool> operator_affects_pattern;
+    bool pdb_is_outdated;
+
+    virtual void notify_operator_cost_raised(int op_id, int cost) override;
 protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
 public:
@@ -26,7 +43,7 @@ public:
        empty, default operator costs are used.
     */
     PDBHeuristic(const options::Options &opts);
-    virtual ~PDBHeuristic() override = default;
+    virtual ~PDBHeuristic() override;
 };
 }
 
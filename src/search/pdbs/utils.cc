@@ -5,6 +5,7 @@
 #include "pattern_information.h"
 
 #include "../utils/logging.h"
+#include "../utils/thread_pool.h"
 
 #include "../task_proxy.h"
 
@@ -28,6 +29,34 @@ int compute_total_pdb_size(
     return size;
 }
 
+PDBCollection compute_pdbs(
+    const TaskProxy &task_proxy, const PatternCollection &patterns,
+    int max_parallel_size) {
+    vector<int> sizes;
+    sizes.reserve(patterns.size());
+    for (const Pattern &pattern : patterns) {
+        sizes.push_back(compute_pdb_size(task_proxy, pattern));
+    }
+    PDBCollection pdbs(patterns.size());
+    utils::run_with_size_budget(
+        sizes, max_parallel_size, [&](int index, int) {
+            pdbs[index] = make_shared<PatternDatabase>(
+                task_proxy, patterns[index]);
+        });
+    return pdbs;
+}
+
+void dump_pdb_construction_throughput(
+    int64_t num_states, utils::Duration runtime) {
+    utils::g_log << "PDB construction throughput: ";
+    if (runtime > 0) {
+        utils::g_log << static_cast<int64_t>(num_states / runtime);
+    } else {
+        utils::g_log << "infinite";
+    }
+    utils::g_log << " abstract states/s" << endl;
+}
+
 void dump_pattern_generation_statistics(
     const string &identifier,
     utils::Duration runtime,
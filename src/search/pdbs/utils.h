@@ -5,6 +5,7 @@
 
 #include "../utils/timer.h"
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -18,6 +19,22 @@ extern int compute_pdb_size(const TaskProxy &task_proxy, const Pattern &pattern)
 extern int compute_total_pdb_size(
     const TaskProxy &task_proxy, const PatternCollection &pattern_collection);
 
+/*
+  Compute the PDBs for the given patterns. With multiple threads, the PDBs
+  are computed in parallel, but only as long as the PDBs under construction
+  have at most max_parallel_size abstract states in total.
+*/
+extern PDBCollection compute_pdbs(
+    const TaskProxy &task_proxy, const PatternCollection &patterns,
+    int max_parallel_size);
+
+/*
+  Dump the number of abstract states per second for building PDBs with the
+  given total number of abstract states in the given time.
+*/
+extern void dump_pdb_construction_throughput(
+    int64_t num_states, utils::Duration runtime);
+
 /*
   Dump the given pattern, the number of variables contained, the size of the
   corresponding PDB, and the runtime used for computing it. All output is
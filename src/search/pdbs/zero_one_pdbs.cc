@@ -15,7 +15,8 @@ using namespace std;
 
 namespace pdbs {
 ZeroOnePDBs::ZeroOnePDBs(
-    const TaskProxy &task_proxy, const PatternCollection &patterns) {
+    const TaskProxy &task_proxy, const PatternCollection &patterns,
+    bool compress) {
     vector<int> remaining_operator_costs;
     OperatorsProxy operators = task_proxy.get_operators();
     remaining_operator_costs.reserve(operators.size());
@@ -26,6 +27,8 @@ ZeroOnePDBs::ZeroOnePDBs(
     for (const Pattern &pattern : patterns) {
         shared_ptr<PatternDatabase> pdb = make_shared<PatternDatabase>(
             task_proxy, pattern, false, remaining_operator_costs);
+        if (compress)
+            pdb->compress();
 
         /* Set cost of relevant operators to 0 for further iterations
            (action cost partitioning). */
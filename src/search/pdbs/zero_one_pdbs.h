@@ -10,7 +10,9 @@ namespace pdbs {
 class ZeroOnePDBs {
     PDBCollection pattern_databases;
 public:
-    ZeroOnePDBs(const TaskProxy &task_proxy, const PatternCollection &patterns);
+    // If compress is true, every PDB is compressed directly after its construction.
+    ZeroOnePDBs(const TaskProxy &task_proxy, const PatternCollection &patterns,
+                bool compress = false);
     ~ZeroOnePDBs() = default;
 
     int get_value(const State &state) const;
@@ -17,7 +17,7 @@ ZeroOnePDBs get_zero_one_pdbs_from_options(
     shared_ptr<PatternCollection> patterns =
         pattern_collection_info.get_patterns();
     TaskProxy task_proxy(*task);
-    return ZeroOnePDBs(task_proxy, *patterns);
+    return ZeroOnePDBs(task_proxy, *patterns, opts.get<bool>("compress"));
 }
 
 ZeroOnePDBsHeuristic::ZeroOnePDBsHeuristic(
@@ -58,6 +58,12 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
         "patterns",
         "pattern generation method",
         "systematic(1)");
+    parser.add_option<bool>(
+        "compress",
+        "store the PDB distances bit-packed with the minimal number of bits "
+        "needed for the largest finite distance. This reduces the memory "
+        "usage considerably at a small cost per lookup.",
+        "false");
     Heuristic::add_options_to_parser(parser);
 
     Options opts = parser.parse();
@@ -18,6 +18,9 @@ public:
 
     void set_plan_filename(const std::string &plan_filename);
     void set_num_previously_generated_plans(int num_previously_generated_plans);
+    int get_num_previously_generated_plans() const {
+        return num_previously_generated_plans;
+    }
     void set_is_part_of_anytime_portfolio(bool is_part_of_anytime_portfolio);
 
     /*
@@ -2,6 +2,7 @@
 #include "option_parser.h"
 #include "search_engine.h"
 
+#include "algorithms/segment_storage.h"
 #include "options/registries.h"
 #include "tasks/root_task.h"
 #include "task_utils/task_properties.h"
@@ -25,7 +26,8 @@ int main(int argc, const char **argv) {
     bool unit_cost = false;
     if (static_cast<string>(argv[1]) != "--help") {
         utils::g_log << "reading input..." << endl;
-        tasks::read_root_task(cin);
+        // Standard input has file descriptor 0.
+        tasks::read_root_task(cin, 0);
         utils::g_log << "done reading input!" << endl;
         TaskProxy task_proxy(*tasks::g_root_task);
         unit_cost = task_properties::is_unit_cost(task_proxy);
@@ -59,6 +61,9 @@ int main(int argc, const char **argv) {
 
     engine->save_plan_if_necessary();
     engine->print_statistics();
+    if (segmented_vector::get_segment_storage()) {
+        segmented_vector::get_segment_storage()->print_statistics();
+    }
     utils::g_log << "Search time: " << search_timer << endl;
     utils::g_log << "Total time: " << utils::g_timer << endl;
 
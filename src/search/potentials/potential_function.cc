@@ -4,26 +4,77 @@
 
 #include "../utils/collections.h"
 
+#include <algorithm>
 #include <cmath>
 
 using namespace std;
 
 namespace potentials {
+static int round_heuristic_value(double heuristic_value) {
+    const double epsilon = 0.01;
+    return static_cast<int>(ceil(heuristic_value - epsilon));
+}
+
 PotentialFunction::PotentialFunction(
-    const vector<vector<double>> &fact_potentials)
-    : fact_potentials(fact_potentials) {
+    const vector<vector<double>> &fact_potentials) {
+    fact_offsets.reserve(fact_potentials.size());
+    for (const vector<double> &potentials : fact_potentials) {
+        fact_offsets.push_back(this->fact_potentials.size());
+        this->fact_potentials.insert(
+            this->fact_potentials.end(), potentials.begin(), potentials.end());
+    }
 }
 
 int PotentialFunction::get_value(const State &state) const {
+    state.unpack();
+    const vector<int> &values = state.get_unpacked_values();
+    assert(values.size() == fact_offsets.size());
     double heuristic_value = 0.0;
-    for (FactProxy fact : state) {
-        int var_id = fact.get_variable().get_id();
-        int value = fact.get_value();
-        assert(utils::in_bounds(var_id, fact_potentials));
-        assert(utils::in_bounds(value, fact_potentials[var_id]));
-        heuristic_value += fact_potentials[var_id][value];
+    for (size_t var = 0; var < values.size(); ++var) {
+        int index = fact_offsets[var] + values[var];
+        assert(utils::in_bounds(index, fact_potentials));
+        heuristic_value += fact_potentials[index];
     }
-    const double epsilon = 0.01;
-    return static_cast<int>(ceil(heuristic_value - epsilon));
+    return round_heuristic_value(heuristic_value);
+}
+
+
+PotentialFunctionCollection::PotentialFunctionCollection(
+    const vector<unique_ptr<PotentialFunction>> &functions)
+    : num_functions(functions.size()),
+      sums(functions.size()) {
+    if (functions.empty())
+        return;
+    fact_offsets = functions[0]->fact_offsets;
+    int num_facts = functions[0]->fact_potentials.size();
+    fact_potentials.resize(num_facts * num_functions);
+    for (int i = 0; i < num_functions; ++i) {
+        const PotentialFunction &function = *functions[i];
+        assert(function.fact_offsets == fact_offsets);
+        for (int fact = 0; fact < num_facts; ++fact) {
+            fact_potentials[fact * num_functions + i] =
+                function.fact_potentials[fact];
+        }
+    }
+}
+
+int PotentialFunctionCollection::get_max_value(const State &state) const {
+    state.unpack();
+    const vector<int> &values = state.get_unpacked_values();
+    assert(num_functions == 0 || values.size() == fact_offsets.size());
+    fill(sums.begin(), sums.end(), 0.0);
+    double *sums_begin = sums.data();
+    for (size_t var = 0; var < fact_offsets.size(); ++var) {
+        const double *potentials = fact_potentials.data() +
+            (fact_offsets[var] + values[var]) * num_functions;
+        for (int i = 0; i < num_functions; ++i) {
+            sums_begin[i] += potentials[i];
+        }
+    }
+    int value = 0;
+    for (double sum : sums) {
+        value = max(value, round_heuristic_value(sum));
+    }
+    return value;
 }
 }
@@ -1,6 +1,7 @@
 #ifndef POTENTIALS_POTENTIAL_FUNCTION_H
 #define POTENTIALS_POTENTIAL_FUNCTION_H
 
+#include <memory>
 #include <vector>
 
 class State;
@@ -13,7 +14,12 @@ namespace potentials {
   overhead that is induced by evaluating heuristics whenever possible.
 */
 class PotentialFunction {
-    const std::vector<std::vector<double>> fact_potentials;
+    friend class PotentialFunctionCollection;
+
+    // Index of the potential of fact (var, 0) in fact_potentials.
+    std::vector<int> fact_offsets;
+    // Potentials of all facts, ordered by variable and value.
+    std::vector<double> fact_potentials;
 
 public:
     explicit PotentialFunction(
@@ -22,6 +28,29 @@ public:
 
     int get_value(const State &state) const;
 };
+
+
+/*
+  Store several potential functions for the same task fact by fact: the
+  potentials of all functions for a fact are contiguous. A state is then
+  evaluated for all functions in one pass over its facts, with an inner
+  loop over the functions that the compiler can vectorize.
+*/
+class PotentialFunctionCollection {
+    int num_functions;
+    std::vector<int> fact_offsets;
+    // Potential of function i for fact f at index f * num_functions + i.
+    std::vector<double> fact_potentials;
+    // Sums of potentials for the state that is evaluated.
+    mutable std::vector<double> sums;
+
+public:
+    explicit PotentialFunctionCollection(
+        const std::vector<std::unique_ptr<PotentialFunction>> &functions);
+
+    // Return the maximum of 0 and the values of all functions.
+    int get_max_value(const State &state) const;
+};
 }
 
 #endif
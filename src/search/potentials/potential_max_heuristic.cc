@@ -11,15 +11,11 @@ PotentialMaxHeuristic::PotentialMaxHeuristic(
     const Options &opts,
     vector<unique_ptr<PotentialFunction>> &&functions)
     : Heuristic(opts),
-      functions(move(functions)) {
+      functions(functions) {
 }
 
 int PotentialMaxHeuristic::compute_heuristic(const State &ancestor_state) {
     State state = convert_ancestor_state(ancestor_state);
-    int value = 0;
-    for (auto &function : functions) {
-        value = max(value, function->get_value(state));
-    }
-    return value;
+    return functions.get_max_value(state);
 }
 }
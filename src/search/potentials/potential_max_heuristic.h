@@ -1,19 +1,19 @@
 #ifndef POTENTIALS_POTENTIAL_MAX_HEURISTIC_H
 #define POTENTIALS_POTENTIAL_MAX_HEURISTIC_H
 
+#include "potential_function.h"
+
 #include "../heuristic.h"
 
 #include <memory>
 #include <vector>
 
 namespace potentials {
-class PotentialFunction;
-
 /*
   Maximize over multiple potential functions.
 */
 class PotentialMaxHeuristic : public Heuristic {
-    std::vector<std::unique_ptr<PotentialFunction>> functions;
+    const PotentialFunctionCollection functions;
 
 protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
@@ -55,6 +55,10 @@ void StubbornSets::initialize(const shared_ptr<AbstractTask> &task) {
 
     compute_sorted_operators(task_proxy);
     compute_achievers(task_proxy);
+    compute_facts_by_var(task_proxy);
+
+    stubborn.assign(num_operators, false);
+    operator_is_marked.assign(num_operators, false);
 }
 
 // Relies on op_preconds and op_effects being sorted by variable.
@@ -69,6 +73,67 @@ bool StubbornSets::can_conflict(int op1_no, int op2_no) const {
                                     sorted_op_effects[op2_no]);
 }
 
+/*
+  Append all operators except op_no that have a fact on the variable of
+  one of the given facts with a different value.
+*/
+static void add_operators_with_other_values(
+    int op_no, const vector<FactPair> &facts,
+    const vector<vector<pair<int, int>>> &facts_by_var,
+    vector<int> &op_nos) {
+    for (const FactPair &fact : facts) {
+        for (const pair<int, int> &op_and_value : facts_by_var[fact.var]) {
+            if (op_and_value.first != op_no && op_and_value.second != fact.value)
+                op_nos.push_back(op_and_value.first);
+        }
+    }
+}
+
+void StubbornSets::add_disabled_operators(int op_no, vector<int> &op_nos) const {
+    add_operators_with_other_values(
+        op_no, sorted_op_effects[op_no], preconditions_by_var, op_nos);
+}
+
+void StubbornSets::add_conflicting_operators(int op_no, vector<int> &op_nos) const {
+    add_operators_with_other_values(
+        op_no, sorted_op_effects[op_no], effects_by_var, op_nos);
+}
+
+void StubbornSets::add_disabling_operators(int op_no, vector<int> &op_nos) const {
+    add_operators_with_other_values(
+        op_no, sorted_op_preconditions[op_no], effects_by_var, op_nos);
+}
+
+void StubbornSets::sort_unique_operators(vector<int> &op_nos) {
+    /*
+      The lists can be long and contain many duplicates, so we filter
+      them with marks before sorting. Long lists are rebuilt from the
+      marks directly.
+    */
+    size_t num_unique = 0;
+    for (int op_no : op_nos) {
+        if (!operator_is_marked[op_no]) {
+            operator_is_marked[op_no] = true;
+            op_nos[num_unique++] = op_no;
+        }
+    }
+    op_nos.resize(num_unique);
+    if (static_cast<int>(num_unique) > num_operators / 16) {
+        op_nos.clear();
+        for (int op_no = 0; op_no < num_operators; ++op_no) {
+            if (operator_is_marked[op_no]) {
+                op_nos.push_back(op_no);
+                operator_is_marked[op_no] = false;
+            }
+        }
+    } else {
+        for (int op_no : op_nos) {
+            operator_is_marked[op_no] = false;
+        }
+        sort(op_nos.begin(), op_nos.end());
+    }
+}
+
 void StubbornSets::compute_sorted_operators(const TaskProxy &task_proxy) {
     OperatorsProxy operators = task_proxy.get_operators();
 
@@ -101,9 +166,22 @@ void StubbornSets::compute_achievers(const TaskProxy &task_proxy) {
     }
 }
 
+void StubbornSets::compute_facts_by_var(const TaskProxy &task_proxy) {
+    int num_variables = task_proxy.get_variables().size();
+    preconditions_by_var.resize(num_variables);
+    effects_by_var.resize(num_variables);
+    for (int op_no = 0; op_no < num_operators; ++op_no) {
+        for (const FactPair &fact : sorted_op_preconditions[op_no]) {
+            preconditions_by_var[fact.var].emplace_back(op_no, fact.value);
+        }
+        for (const FactPair &fact : sorted_op_effects[op_no]) {
+            effects_by_var[fact.var].emplace_back(op_no, fact.value);
+        }
+    }
+}
+
 bool StubbornSets::mark_as_stubborn(int op_no) {
-    if (!stubborn[op_no]) {
-        stubborn[op_no] = true;
+    if (add_to_stubborn_set(op_no)) {
         stubborn_queue.push_back(op_no);
         return true;
     }
@@ -135,7 +213,10 @@ void StubbornSets::prune_operators(
     ++num_pruning_calls;
 
     // Clear stubborn set from previous call.
-    stubborn.assign(num_operators, false);
+    for (int op_no : stubborn_operators) {
+        stubborn[op_no] = false;
+    }
+    stubborn_operators.clear();
     assert(stubborn_queue.empty());
 
     initialize_stubborn_set(state);
@@ -147,15 +228,11 @@ void StubbornSets::prune_operators(
         handle_stubborn_operator(state, op_no);
     }
 
-    // Now check which applicable operators are in the stubborn set.
-    vector<OperatorID> remaining_op_ids;
-    remaining_op_ids.reserve(op_ids.size());
-    for (OperatorID op_id : op_ids) {
-        if (stubborn[op_id.get_index()]) {
-            remaining_op_ids.emplace_back(op_id);
-        }
-    }
-    op_ids.swap(remaining_op_ids);
+    // Now keep only the applicable operators in the stubborn set.
+    op_ids.erase(
+        remove_if(op_ids.begin(), op_ids.end(),
+                  [&](OperatorID op_id) {return !stubborn[op_id.get_index()];}),
+        op_ids.end());
 
     num_pruned_successors_generated += op_ids.size();
 
@@ -6,6 +6,9 @@
 
 #include "../utils/timer.h"
 
+#include <utility>
+#include <vector>
+
 namespace options {
 class OptionParser;
 }
@@ -32,8 +35,26 @@ class StubbornSets : public PruningMethod {
     */
     std::vector<int> stubborn_queue;
 
+    /*
+      All operators that have been added to the stubborn set in the
+      current call. Only their entries of stubborn are reset for the next
+      call.
+    */
+    std::vector<int> stubborn_operators;
+
+    /*
+      preconditions_by_var[var] and effects_by_var[var] contain the pairs
+      (op_no, value) of all operators with a precondition or effect
+      var=value, ordered by operator.
+    */
+    std::vector<std::vector<std::pair<int, int>>> preconditions_by_var;
+    std::vector<std::vector<std::pair<int, int>>> effects_by_var;
+    // Scratch space for sort_unique_operators(), always all false.
+    std::vector<bool> operator_is_marked;
+
     void compute_sorted_operators(const TaskProxy &task_proxy);
     void compute_achievers(const TaskProxy &task_proxy);
+    void compute_facts_by_var(const TaskProxy &task_proxy);
 
 protected:
     /*
@@ -56,6 +77,19 @@ protected:
     bool can_disable(int op1_no, int op2_no) const;
     bool can_conflict(int op1_no, int op2_no) const;
 
+    /*
+      Append all operators op2_no != op_no with can_disable(op_no, op2_no),
+      can_conflict(op_no, op2_no) or can_disable(op2_no, op_no),
+      respectively. Only operators that mention a variable affected or
+      required by op_no are considered, so this is much cheaper than
+      testing all operators. The result may contain duplicates.
+    */
+    void add_disabled_operators(int op_no, std::vector<int> &op_nos) const;
+    void add_conflicting_operators(int op_no, std::vector<int> &op_nos) const;
+    void add_disabling_operators(int op_no, std::vector<int> &op_nos) const;
+    // Sort the operators and remove duplicates.
+    void sort_unique_operators(std::vector<int> &op_nos);
+
     /*
       Return the first unsatified goal pair,
       or FactPair::no_fact if there is none.
@@ -88,6 +122,15 @@ protected:
         return find_unsatisfied_condition(sorted_op_preconditions[op_no], state);
     }
 
+    // Return true iff the operator was not in the stubborn set before.
+    bool add_to_stubborn_set(int op_no) {
+        if (stubborn[op_no])
+            return false;
+        stubborn[op_no] = true;
+        stubborn_operators.push_back(op_no);
+        return true;
+    }
+
     // Return true iff the operator was enqueued.
     // TODO: rename to enqueue_stubborn_operator?
     bool mark_as_stubborn(int op_no);
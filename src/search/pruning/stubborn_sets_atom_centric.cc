@@ -233,8 +233,7 @@ void StubbornSetsAtomCentric::initialize_stubborn_set(const State &state) {
 }
 
 void StubbornSetsAtomCentric::handle_stubborn_operator(const State &state, int op) {
-    if (!stubborn[op]) {
-        stubborn[op] = true;
+    if (add_to_stubborn_set(op)) {
         if (operator_is_applicable(op, state)) {
             enqueue_interferers(op);
         } else {
@@ -185,15 +185,9 @@ void StubbornSetsEC::compute_active_operators(const State &state) {
 const vector<int> &StubbornSetsEC::get_conflicting_and_disabling(int op1_no) {
     vector<int> &result = conflicting_and_disabling[op1_no];
     if (!conflicting_and_disabling_computed[op1_no]) {
-        for (int op2_no = 0; op2_no < num_operators; ++op2_no) {
-            if (op1_no != op2_no) {
-                bool conflict = can_conflict(op1_no, op2_no);
-                bool disable = can_disable(op2_no, op1_no);
-                if (conflict || disable) {
-                    result.push_back(op2_no);
-                }
-            }
-        }
+        add_conflicting_operators(op1_no, result);
+        add_disabling_operators(op1_no, result);
+        sort_unique_operators(result);
         result.shrink_to_fit();
         conflicting_and_disabling_computed[op1_no] = true;
     }
@@ -203,11 +197,8 @@ const vector<int> &StubbornSetsEC::get_conflicting_and_disabling(int op1_no) {
 const vector<int> &StubbornSetsEC::get_disabled(int op1_no) {
     vector<int> &result = disabled[op1_no];
     if (!disabled_computed[op1_no]) {
-        for (int op2_no = 0; op2_no < num_operators; ++op2_no) {
-            if (op2_no != op1_no && can_disable(op1_no, op2_no)) {
-                result.push_back(op2_no);
-            }
-        }
+        add_disabled_operators(op1_no, result);
+        sort_unique_operators(result);
         result.shrink_to_fit();
         disabled_computed[op1_no] = true;
     }
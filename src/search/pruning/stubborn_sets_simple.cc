@@ -22,18 +22,12 @@ void StubbornSetsSimple::initialize(const shared_ptr<AbstractTask> &task) {
 }
 
 const vector<int> &StubbornSetsSimple::get_interfering_operators(int op1_no) {
-    /*
-       TODO: as interference is symmetric, we only need to compute the
-       relation for operators (o1, o2) with (o1 < o2) and add a lookup
-       method that looks up (i, j) if i < j and (j, i) otherwise.
-    */
     vector<int> &interfere_op1 = interference_relation[op1_no];
     if (!interference_relation_computed[op1_no]) {
-        for (int op2_no = 0; op2_no < num_operators; ++op2_no) {
-            if (op1_no != op2_no && interfere(op1_no, op2_no)) {
-                interfere_op1.push_back(op2_no);
-            }
-        }
+        add_disabled_operators(op1_no, interfere_op1);
+        add_conflicting_operators(op1_no, interfere_op1);
+        add_disabling_operators(op1_no, interfere_op1);
+        sort_unique_operators(interfere_op1);
         interfere_op1.shrink_to_fit();
         interference_relation_computed[op1_no] = true;
     }
@@ -0,0 +1,80 @@
+#include "search_checkpoint.h"
+
+#include "utils/logging.h"
+#include "utils/system.h"
+
+#include <cstdio>
+#include <iostream>
+
+using namespace std;
+
+namespace search_checkpoint {
+static string checkpoint_file_name;
+static double checkpoint_interval = 0;
+
+void set_checkpoint_options(const string &file_name, double interval) {
+    checkpoint_file_name = file_name;
+    checkpoint_interval = interval;
+}
+
+bool checkpoints_are_enabled() {
+    return !checkpoint_file_name.empty();
+}
+
+string get_checkpoint_file(const string &kind) {
+    assert(checkpoints_are_enabled());
+    return checkpoint_file_name + "." + kind;
+}
+
+double get_checkpoint_interval() {
+    return checkpoint_interval;
+}
+
+CheckpointWriter::CheckpointWriter(const string &file_name)
+    : file_name(file_name),
+      tmp_file_name(file_name + ".tmp"),
+      stream(tmp_file_name, ios::binary | ios::trunc) {
+    if (!stream) {
+        cerr << "Could not open checkpoint file " << tmp_file_name << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+}
+
+void CheckpointWriter::write_string(const string &value) {
+    write<int64_t>(value.size());
+    stream.write(value.data(), value.size());
+}
+
+void CheckpointWriter::commit() {
+    stream.close();
+    if (stream.fail() || rename(tmp_file_name.c_str(), file_name.c_str()) != 0) {
+        cerr << "Could not write checkpoint file " << file_name << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+}
+
+CheckpointReader::CheckpointReader(const string &file_name)
+    : file(file_name),
+      pos(0) {
+}
+
+void CheckpointReader::check_remaining(size_t num_bytes) const {
+    if (num_bytes > file.get_size() - pos) {
+        cerr << "Checkpoint file is truncated." << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+}
+
+string CheckpointReader::read_string() {
+    size_t size = read<int64_t>();
+    return string(read_bytes(size), size);
+}
+
+bool CheckpointTimer::is_due() const {
+    return timer() >= checkpoint_interval;
+}
+
+void CheckpointTimer::reset() {
+    timer.reset();
+}
+}
@@ -0,0 +1,134 @@
+#ifndef SEARCH_CHECKPOINT_H
+#define SEARCH_CHECKPOINT_H
+
+#include "utils/mapped_file.h"
+#include "utils/timer.h"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/*
+  Checkpoints allow long searches to be resumed after the planner has been
+  interrupted, e.g., when a job scheduler preempts it.
+
+  Checkpointing is enabled with the command-line option --checkpoint FILE.
+  Engines that support checkpoints periodically write a binary snapshot
+  of their progress to FILE.<kind>, where <kind> identifies the type of
+  engine (e.g., "search" for the BEAUTY search and "iterations" for the
+  iterated engines wrapping it). When the planner is started again with
+  the same task and options, the engines continue from their snapshots.
+  Snapshots are removed once the corresponding search has finished.
+
+  Snapshots are written to a temporary file that replaces the previous
+  snapshot only after it has been written completely, so an interrupted
+  write never destroys the last consistent snapshot. Snapshots are read
+  through a memory mapping.
+*/
+
+namespace search_checkpoint {
+extern void set_checkpoint_options(const std::string &file_name, double interval);
+extern bool checkpoints_are_enabled();
+extern std::string get_checkpoint_file(const std::string &kind);
+extern double get_checkpoint_interval();
+
+class CheckpointWriter {
+    std::string file_name;
+    std::string tmp_file_name;
+    std::ofstream stream;
+
+public:
+    explicit CheckpointWriter(const std::string &file_name);
+
+    template<typename T>
+    void write(const T &value) {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "only trivially copyable types can be written");
+        stream.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    void write_vector(const std::vector<T> &values) {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "only trivially copyable types can be written");
+        write<int64_t>(values.size());
+        stream.write(reinterpret_cast<const char *>(values.data()),
+                     values.size() * sizeof(T));
+    }
+
+    void write_bytes(const void *data, size_t num_bytes) {
+        stream.write(static_cast<const char *>(data), num_bytes);
+    }
+
+    void write_string(const std::string &value);
+
+    /*
+      Flush the snapshot and atomically replace the previous snapshot with
+      it. Exits with an error if the snapshot could not be written.
+    */
+    void commit();
+};
+
+class CheckpointReader {
+    utils::MappedFile file;
+    size_t pos;
+
+    void check_remaining(size_t num_bytes) const;
+public:
+    explicit CheckpointReader(const std::string &file_name);
+
+    bool is_open() const {
+        return file.is_open();
+    }
+
+    template<typename T>
+    T read() {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "only trivially copyable types can be read");
+        check_remaining(sizeof(T));
+        T value;
+        memcpy(&value, file.get_data() + pos, sizeof(T));
+        pos += sizeof(T);
+        return value;
+    }
+
+    template<typename T>
+    std::vector<T> read_vector() {
+        size_t size = read<int64_t>();
+        check_remaining(size * sizeof(T));
+        std::vector<T> values(size);
+        memcpy(values.data(), file.get_data() + pos, size * sizeof(T));
+        pos += size * sizeof(T);
+        return values;
+    }
+
+    /*
+      Return a pointer to the next num_bytes bytes of the snapshot without
+      copying them. The pointer stays valid as long as the reader exists.
+    */
+    const char *read_bytes(size_t num_bytes) {
+        check_remaining(num_bytes);
+        const char *data = file.get_data() + pos;
+        pos += num_bytes;
+        return data;
+    }
+
+    std::string read_string();
+};
+
+/*
+  Keeps track of when the next periodic snapshot is due.
+*/
+class CheckpointTimer {
+    utils::Timer timer;
+public:
+    bool is_due() const;
+    void reset();
+};
+}
+
+#endif
@@ -10,12 +10,14 @@
 #include "task_utils/task_properties.h"
 #include "tasks/root_task.h"
 #include "utils/countdown_timer.h"
+#include "utils/hash.h"
 #include "utils/logging.h"
 #include "utils/rng_options.h"
 #include "utils/system.h"
 #include "utils/timer.h"
 
 #include <cassert>
+#include <cstdio>
 #include <iostream>
 #include <limits>
 
@@ -24,6 +26,9 @@ using utils::ExitCode;
 
 class PruningMethod;
 
+static const string CHECKPOINT_MAGIC = "downward-checkpoint";
+static const int CHECKPOINT_VERSION = 1;
+
 successor_generator::SuccessorGenerator &get_successor_generator(const TaskProxy &task_proxy) {
     utils::g_log << "Building successor generator..." << flush;
     int peak_memory_before = utils::get_peak_memory_in_kb();
@@ -94,13 +99,24 @@ void SearchEngine::set_plan(const Plan &p) {
 void SearchEngine::search() {
     initialize();
     utils::CountdownTimer timer(max_time);
+    checkpoint_timer.reset();
     while (status == IN_PROGRESS) {
         status = step();
         if (timer.is_expired()) {
             utils::g_log << "Time limit reached. Abort search." << endl;
+            if (status == IN_PROGRESS) {
+                // Allow continuing the search later with more time.
+                write_checkpoint();
+            }
             status = TIMEOUT;
             break;
         }
+        if (status == IN_PROGRESS) {
+            save_checkpoint_if_due();
+        }
+    }
+    if (status == SOLVED || status == FAILED) {
+        remove_checkpoint();
     }
     // TODO: Revise when and which search times are logged.
     utils::g_log << "Actual search time: " << timer.get_elapsed_time() << endl;
@@ -127,6 +143,133 @@ int SearchEngine::get_adjusted_cost(const OperatorProxy &op) const {
     return get_adjusted_action_cost(op, cost_type, is_unit_cost);
 }
 
+static uint64_t compute_task_fingerprint(const TaskProxy &task_proxy) {
+    utils::HashState hash_state;
+    for (VariableProxy var : task_proxy.get_variables()) {
+        utils::feed(hash_state, var.get_domain_size());
+    }
+    for (OperatorProxy op : task_proxy.get_operators()) {
+        utils::feed(hash_state, op.get_cost());
+        for (FactProxy pre : op.get_preconditions()) {
+            utils::feed(hash_state, pre.get_pair());
+        }
+        for (EffectProxy eff : op.get_effects()) {
+            utils::feed(hash_state, eff.get_fact().get_pair());
+        }
+    }
+    for (FactProxy goal : task_proxy.get_goals()) {
+        utils::feed(hash_state, goal.get_pair());
+    }
+    utils::feed(hash_state, task_proxy.get_initial_state());
+    return hash_state.get_hash64();
+}
+
+bool SearchEngine::is_checkpoint_due() const {
+    return checkpoint_timer.is_due();
+}
+
+void SearchEngine::write_checkpoint() {
+    string kind = get_checkpoint_kind();
+    if (!search_checkpoint::checkpoints_are_enabled() || kind.empty()) {
+        return;
+    }
+    utils::Timer write_timer;
+    string file_name = search_checkpoint::get_checkpoint_file(kind);
+    search_checkpoint::CheckpointWriter writer(file_name);
+    writer.write_string(CHECKPOINT_MAGIC);
+    writer.write(CHECKPOINT_VERSION);
+    writer.write_string(kind);
+    writer.write(compute_task_fingerprint(task_proxy));
+    save_checkpoint(writer);
+    writer.commit();
+    utils::g_log << "Wrote checkpoint " << file_name << " ["
+                 << write_timer << "]" << endl;
+    checkpoint_timer.reset();
+}
+
+void SearchEngine::save_checkpoint_if_due() {
+    if (search_checkpoint::checkpoints_are_enabled() &&
+        !get_checkpoint_kind().empty() && is_checkpoint_due()) {
+        write_checkpoint();
+    }
+}
+
+void SearchEngine::remove_checkpoint() {
+    string kind = get_checkpoint_kind();
+    if (search_checkpoint::checkpoints_are_enabled() && !kind.empty()) {
+        remove(search_checkpoint::get_checkpoint_file(kind).c_str());
+    }
+}
+
+bool SearchEngine::resume_from_checkpoint() {
+    string kind = get_checkpoint_kind();
+    if (!search_checkpoint::checkpoints_are_enabled() || kind.empty()) {
+        return false;
+    }
+    string file_name = search_checkpoint::get_checkpoint_file(kind);
+    if (!utils::file_exists(file_name)) {
+        return false;
+    }
+    utils::Timer load_timer;
+    search_checkpoint::CheckpointReader reader(file_name);
+    if (!reader.is_open()) {
+        utils::g_log << "Could not read checkpoint " << file_name
+                     << " -- starting from scratch." << endl;
+        return false;
+    }
+    if (reader.read_string() != CHECKPOINT_MAGIC ||
+        reader.read<int>() != CHECKPOINT_VERSION ||
+        reader.read_string() != kind) {
+        utils::g_log << "Checkpoint " << file_name << " has an unknown format"
+                     << " -- starting from scratch." << endl;
+        return false;
+    }
+    if (reader.read<uint64_t>() != compute_task_fingerprint(task_proxy)) {
+        utils::g_log << "Checkpoint " << file_name << " belongs to a different"
+                     << " task -- starting from scratch." << endl;
+        return false;
+    }
+    if (!load_checkpoint(reader)) {
+        utils::g_log << "Checkpoint " << file_name << " does not match the"
+                     << " search configuration -- starting from scratch." << endl;
+        return false;
+    }
+    utils::g_log << "Resumed search from checkpoint " << file_name << " ["
+                 << load_timer << "]" << endl;
+    return true;
+}
+
+void SearchEngine::save_search_space_checkpoint(
+    search_checkpoint::CheckpointWriter &writer) const {
+    writer.write(l_est);
+    writer.write(l_prune);
+    writer.write(target_epsilon);
+    writer.write(l_low);
+    writer.write(l_high);
+    writer.write(opt);
+    writer.write(uncertainty_ratio);
+    statistics.save(writer);
+    state_registry.save(writer);
+    search_space.save(writer);
+}
+
+bool SearchEngine::load_search_space_checkpoint(
+    search_checkpoint::CheckpointReader &reader) {
+    if (reader.read<int>() != l_est ||
+        reader.read<int>() != l_prune ||
+        reader.read<double>() != target_epsilon) {
+        return false;
+    }
+    l_low = reader.read<int>();
+    l_high = reader.read<int>();
+    opt = reader.read<bool>();
+    uncertainty_ratio = reader.read<double>();
+    statistics.load(reader);
+    state_registry.load(reader);
+    search_space.load(reader);
+    return true;
+}
+
 /* TODO: merge this into add_options_to_parser when all search
          engines support pruning.
 
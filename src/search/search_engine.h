@@ -4,12 +4,14 @@
 #include "operator_cost.h"
 #include "operator_id.h"
 #include "plan_manager.h"
+#include "search_checkpoint.h"
 #include "search_progress.h"
 #include "search_space.h"
 #include "search_statistics.h"
 #include "state_registry.h"
 #include "task_proxy.h"
 
+#include <string>
 #include <vector>
 
 namespace options {
@@ -36,6 +38,11 @@ class SearchEngine {
     SearchStatus status;
     bool solution_found;
     Plan plan;
+    search_checkpoint::CheckpointTimer checkpoint_timer;
+
+    void write_checkpoint();
+    void save_checkpoint_if_due();
+    void remove_checkpoint();
 protected:
     // Hold a reference to the task implementation and pass it to objects that need it.
     const std::shared_ptr<AbstractTask> task;
@@ -67,6 +74,36 @@ protected:
     void set_plan(const Plan &plan);
     bool check_goal_and_set_plan(const State &state);
     int get_adjusted_cost(const OperatorProxy &op) const;
+
+    /*
+      Checkpoint support (see search_checkpoint.h). Engines that support
+      checkpoints return a non-empty kind and implement save_checkpoint()
+      and load_checkpoint(). The latter returns false if the snapshot does
+      not fit the current configuration of the engine, in which case the
+      engine must not have been modified. By default, snapshots are written
+      whenever the checkpoint interval has passed.
+    */
+    virtual std::string get_checkpoint_kind() const {return "";}
+    virtual void save_checkpoint(search_checkpoint::CheckpointWriter &) const {}
+    virtual bool load_checkpoint(search_checkpoint::CheckpointReader &) {return false;}
+    virtual bool is_checkpoint_due() const;
+
+    /*
+      Load the snapshot of this engine if checkpoints are enabled and a
+      compatible snapshot for the current task exists. Engines call this
+      from initialize().
+    */
+    bool resume_from_checkpoint();
+
+    /*
+      Store and restore the search bounds, statistics, registered states
+      and search nodes. Loading fails without modifying the engine if the
+      snapshot was written with different search bounds.
+    */
+    void save_search_space_checkpoint(
+        search_checkpoint::CheckpointWriter &writer) const;
+    bool load_search_space_checkpoint(
+        search_checkpoint::CheckpointReader &reader);
 public:
     SearchEngine(const options::Options &opts);
     virtual ~SearchEngine();
@@ -101,6 +101,58 @@ SearchStatus AnytimeBeauty::step() {
     return step_return_value();
 }
 
+void AnytimeBeauty::initialize() {
+    resume_from_checkpoint();
+}
+
+string AnytimeBeauty::get_checkpoint_kind() const {
+    return "iterations";
+}
+
+bool AnytimeBeauty::is_checkpoint_due() const {
+    // Iterations take long, so we save the progress after each of them.
+    return true;
+}
+
+void AnytimeBeauty::save_checkpoint(
+    search_checkpoint::CheckpointWriter &writer) const {
+    writer.write(iter);
+    writer.write(solution_obtained);
+    writer.write(opt);
+    writer.write(l_low);
+    writer.write(l_high);
+    vector<int> plan_op_ids;
+    if (found_solution()) {
+        for (OperatorID op_id : get_plan()) {
+            plan_op_ids.push_back(op_id.get_index());
+        }
+    }
+    writer.write(found_solution());
+    writer.write_vector(plan_op_ids);
+    writer.write(plan_manager.get_num_previously_generated_plans());
+    statistics.save(writer);
+}
+
+bool AnytimeBeauty::load_checkpoint(search_checkpoint::CheckpointReader &reader) {
+    iter = reader.read<int>();
+    solution_obtained = reader.read<bool>();
+    opt = reader.read<bool>();
+    l_low = reader.read<int>();
+    l_high = reader.read<int>();
+    bool has_plan = reader.read<bool>();
+    vector<int> plan_op_ids = reader.read_vector<int>();
+    if (has_plan) {
+        Plan best_plan;
+        for (int op_id : plan_op_ids) {
+            best_plan.emplace_back(op_id);
+        }
+        set_plan(best_plan);
+    }
+    plan_manager.set_num_previously_generated_plans(reader.read<int>());
+    statistics.load(reader);
+    return true;
+}
+
 SearchStatus AnytimeBeauty::step_return_value() {
     if (not solution_obtained) {
         utils::g_log << endl << "Search exhausted and no solution found" << endl;
@@ -28,8 +28,16 @@ class AnytimeBeauty : public SearchEngine {
     std::shared_ptr<SearchEngine> get_search_engine();
     SearchStatus step_return_value();
 
+    virtual void initialize() override;
     virtual SearchStatus step() override;
 
+    virtual std::string get_checkpoint_kind() const override;
+    virtual bool is_checkpoint_due() const override;
+    virtual void save_checkpoint(
+        search_checkpoint::CheckpointWriter &writer) const override;
+    virtual bool load_checkpoint(
+        search_checkpoint::CheckpointReader &reader) override;
+
 public:
     AnytimeBeauty(const options::Options &opts, options::Registry &registry,
                    const options::Predefinitions &predefinitions);
@@ -8,9 +8,10 @@
 #include "../option_parser.h"
 #include "../pruning_method.h"
 
-#include "../algorithms/ordered_set.h"
 #include "../task_utils/successor_generator.h"
+#include "../tasks/estimated_operator_costs_task.h"
 #include "../utils/logging.h"
+#include "../utils/thread_pool.h"
 
 #include <cassert>
 #include <cstdlib>
@@ -32,6 +33,8 @@ Beauty::Beauty(const Options &opts)
       preferred_operator_evaluators(opts.get_list<shared_ptr<Evaluator>>("preferred")),
       lazy_evaluator(opts.get<shared_ptr<Evaluator>>("lazy_evaluator", nullptr)),
       pruning_method(opts.get<shared_ptr<PruningMethod>>("pruning")),
+      expansion_arena(task_proxy.get_operators().size()),
+      batch_evaluation(false),
       seed(opts.get<int>("seed")),
       factor_first(opts.get<int>("factor_first")),
       factor_second(opts.get<int>("factor_second")),
@@ -81,6 +84,22 @@ void Beauty::initialize() {
 
     path_dependent_evaluators.assign(evals.begin(), evals.end());
 
+    /*
+      Path-dependent evaluators must see the successors in the order in
+      which they are generated, so we only evaluate batches without them.
+    */
+    batch_evaluation = utils::get_thread_pool() && path_dependent_evaluators.empty();
+
+    if (search_checkpoint::checkpoints_are_enabled() &&
+        !path_dependent_evaluators.empty()) {
+        utils::g_log << "Checkpoints are not supported with path-dependent "
+                     << "evaluators and will not be written." << endl;
+    }
+    if (resume_from_checkpoint()) {
+        pruning_method->initialize(task);
+        return;
+    }
+
     State initial_state = state_registry.get_initial_state();
     for (Evaluator *evaluator : path_dependent_evaluators) {
         evaluator->notify_initial_state(initial_state);
@@ -111,10 +130,67 @@ void Beauty::initialize() {
     pruning_method->initialize(task);
 }
 
+string Beauty::get_checkpoint_kind() const {
+    /*
+      The information of path-dependent evaluators cannot be restored, so
+      we only support checkpoints without them.
+    */
+    return path_dependent_evaluators.empty() ? "search" : "";
+}
+
+void Beauty::save_checkpoint(
+    search_checkpoint::CheckpointWriter &writer) const {
+    save_search_space_checkpoint(writer);
+}
+
+bool Beauty::load_checkpoint(search_checkpoint::CheckpointReader &reader) {
+    if (!load_search_space_checkpoint(reader)) {
+        return false;
+    }
+    reinsert_open_nodes();
+    return true;
+}
+
+/*
+  Instead of storing the open list, we rebuild it from the open nodes of
+  the restored search space. This evaluates all open states once more but
+  works for all open lists. Note that we do not know anymore whether the
+  states were reached by preferred operators.
+*/
+void Beauty::reinsert_open_nodes() {
+    int num_open_nodes = 0;
+    for (StateID id : state_registry) {
+        State state = state_registry.lookup_state(id);
+        SearchNode node = search_space.get_node(state);
+        if (!node.is_open())
+            continue;
+        EvaluationContext eval_context(state, node.get_g(), false, &statistics);
+        if (!open_list->is_dead_end(eval_context)) {
+            open_list->insert(eval_context, id);
+            ++num_open_nodes;
+        }
+    }
+    utils::g_log << "Reinserted " << num_open_nodes << " open states." << endl;
+}
+
 void Beauty::print_statistics() const {
     statistics.print_detailed_statistics();
     search_space.print_statistics();
     pruning_method->print_statistics();
+    expansion_arena.print_statistics();
+    extra_tasks::print_estimated_operator_costs_statistics();
+}
+
+void Beauty::raise_estimated_cost(
+    OperatorID op_id, const EstimationInfo &estimation_info) {
+    /*
+      The estimators derive their bounds from the operator alone, so the
+      bound of an edge is a lower bound on the true cost of its operator.
+      Estimated costs only make sense relative to the original costs.
+    */
+    if (cost_type == NORMAL)
+        extra_tasks::raise_estimated_operator_cost(
+            op_id.get_index(), estimation_info.min_cost);
 }
 
 SearchStatus Beauty::step() {
@@ -195,7 +271,8 @@ SearchStatus Beauty::step() {
     }
     // statistics.print_checkpoint_line(node->get_g()); // for debugging
 
-    vector<OperatorID> applicable_ops;
+    expansion_arena.reset();
+    vector<OperatorID> &applicable_ops = expansion_arena.get_applicable_ops();
     successor_generator.generate_applicable_ops(s, applicable_ops);
 
     /*
@@ -206,11 +283,9 @@ SearchStatus Beauty::step() {
 
     // This evaluates the expanded state (again) to get preferred ops
     EvaluationContext eval_context(s, node->get_g(), false, &statistics, true);
-    ordered_set::OrderedSet<OperatorID> preferred_operators;
     for (const shared_ptr<Evaluator> &preferred_operator_evaluator : preferred_operator_evaluators) {
-        collect_preferred_operators(eval_context,
-                                    preferred_operator_evaluator.get(),
-                                    preferred_operators);
+        expansion_arena.collect_preferred_operators(
+            eval_context, preferred_operator_evaluator.get());
     }
 
     // utils::g_log << "applicable_ops.size is: " << applicable_ops.size() << endl; // for debugging
@@ -222,7 +297,11 @@ SearchStatus Beauty::step() {
 
         State succ_state = state_registry.get_successor_state(s, op);
         statistics.inc_generated();
-        bool is_preferred = preferred_operators.contains(op_id);
+        bool is_preferred = expansion_arena.is_preferred(op_id);
+
+        // Duplicates within the current batch see the inserted node.
+        if (is_new_successor(succ_state))
+            insert_new_successors(*node);
 
         SearchNode succ_node = search_space.get_node(succ_state);
 
@@ -291,6 +370,7 @@ SearchStatus Beauty::step() {
                 first_estimate = false;
                 // utils::g_log << "new node, estimation_info.min_g is: " << estimation_info.min_g  << endl; // for debugging
             } while (estimation_info.min_g <= l_est);
+            raise_estimated_cost(op_id, estimation_info);
 
             // We have not seen this state before.
             // Evaluate and create a new node.
@@ -300,29 +380,11 @@ SearchStatus Beauty::step() {
             // TODO: Make this less fragile.
             int succ_g = node->get_g() + get_adjusted_cost(op);
 
-            EvaluationContext succ_eval_context(
-                succ_state, succ_g, is_preferred, &statistics, &estimation_info);
-            statistics.inc_evaluated_states();
-
-            if (open_list->is_dead_end(succ_eval_context)) {
-                succ_node.mark_as_dead_end();
-                statistics.inc_dead_ends();
-                continue;
-            }
-
-            if (estimation_info.min_g > l_prune) {
-                statistics.inc_pruned_states();
-                continue;
-            }
-
-            succ_node.open(*node, op, get_adjusted_cost(op), &estimation_info);
-
-            open_list->insert(succ_eval_context, succ_state.get_id());
-            if (search_progress.check_progress(succ_eval_context)) {
-                statistics.print_checkpoint_line(succ_node.get_g());
-                // utils::g_log << "Current lower bound for l* is: " << estimation_info.min_g  << endl; // for debugging
-                reward_progress();
-            }
+            new_successors.emplace_back(
+                succ_state, op_id, estimation_info, succ_g, is_preferred,
+                &statistics);
+            if (!batch_evaluation)
+                insert_new_successors(*node);
         } else {
             if (succ_node.is_same_edge(*node, op)) { // Already done edge estimations.
                 search_space.set_estimation_info_based_on_edge(estimation_info,
@@ -381,6 +443,7 @@ SearchStatus Beauty::step() {
                     // utils::g_log << "old node, estimation_info.min_g is: " << estimation_info.min_g  << endl; // for debugging
                 } while ((estimation_info.min_g <= l_est) and
                          (estimation_info.min_g < succ_node.get_min_g()));
+                raise_estimated_cost(op_id, estimation_info);
             }
             
             if ((estimation_info.min_g < succ_node.get_min_g()) and
@@ -403,6 +466,8 @@ SearchStatus Beauty::step() {
                         succ_node.info.curr_estimation.max_g = succ_curr_cost_max;
                     */
 
+                    // Keep the order of insertions into the open list.
+                    insert_new_successors(*node);
                     succ_node.reopen(*node, op, get_adjusted_cost(op), &estimation_info);
 
                     EvaluationContext succ_eval_context(
@@ -436,9 +501,71 @@ SearchStatus Beauty::step() {
             } 
         }
     }
+    insert_new_successors(*node);
     return IN_PROGRESS;
 }
 
+Beauty::NewSuccessor::NewSuccessor(
+    const State &state, OperatorID op_id,
+    const EstimationInfo &estimation_info, int g, bool is_preferred,
+    SearchStatistics *statistics)
+    : state(state),
+      op_id(op_id),
+      estimation_info(estimation_info),
+      eval_context(state, g, is_preferred, statistics,
+                   &this->estimation_info) {
+}
+
+bool Beauty::is_new_successor(const State &state) const {
+    for (const NewSuccessor &successor : new_successors) {
+        if (successor.state.get_id() == state.get_id())
+            return true;
+    }
+    return false;
+}
+
+void Beauty::insert_new_successor(
+    const SearchNode &node, NewSuccessor &successor) {
+    SearchNode succ_node = search_space.get_node(successor.state);
+    EvaluationContext &succ_eval_context = successor.eval_context;
+    statistics.inc_evaluated_states();
+
+    if (open_list->is_dead_end(succ_eval_context)) {
+        succ_node.mark_as_dead_end();
+        statistics.inc_dead_ends();
+        return;
+    }
+
+    if (successor.estimation_info.min_g > l_prune) {
+        statistics.inc_pruned_states();
+        return;
+    }
+
+    OperatorProxy op = task_proxy.get_operators()[successor.op_id];
+    succ_node.open(node, op, get_adjusted_cost(op), &successor.estimation_info);
+
+    open_list->insert(succ_eval_context, successor.state.get_id());
+    if (search_progress.check_progress(succ_eval_context)) {
+        statistics.print_checkpoint_line(succ_node.get_g());
+        reward_progress();
+    }
+}
+
+void Beauty::insert_new_successors(const SearchNode &node) {
+    if (new_successors.empty())
+        return;
+    if (batch_evaluation && new_successors.size() > 1) {
+        vector<EvaluationContext *> eval_contexts;
+        eval_contexts.reserve(new_successors.size());
+        for (NewSuccessor &successor : new_successors)
+            eval_contexts.push_back(&successor.eval_context);
+        open_list->compute_results(eval_contexts);
+    }
+    for (NewSuccessor &successor : new_successors)
+        insert_new_successor(node, successor);
+    new_successors.clear();
+}
+
 void Beauty::perform_end_of_search_estimations(const State &state) {   
     // initialization
     State curr_state = state;
@@ -462,11 +589,11 @@ void Beauty::perform_end_of_search_estimations(const State &state) {
         SearchNode curr_node = search_space.get_node(curr_state);
         StateID parent_state_id = curr_node.get_parent_state_id();
         OperatorID creating_operator_id = curr_node.get_creating_operator();
-        OperatorProxy op = task_proxy.get_operators()[creating_operator_id];
         if (creating_operator_id == OperatorID::no_operator) {
             assert(parent_state_id == StateID::no_state);
             break;
         }
+        OperatorProxy op = task_proxy.get_operators()[creating_operator_id];
         // inner loop over estimators for edge
         State parent_state = state_registry.lookup_state(parent_state_id);
         SearchNode parent_node = search_space.get_node(parent_state);
@@ -508,6 +635,7 @@ void Beauty::perform_end_of_search_estimations(const State &state) {
                                             get_adjusted_cost(op),
                                             seed);
         }
+        raise_estimated_cost(creating_operator_id, estimation_info);
         curr_state = state_registry.lookup_state(parent_state_id);
     }
 
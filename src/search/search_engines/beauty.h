@@ -1,10 +1,13 @@
 #ifndef SEARCH_ENGINES_BEAUTY_H
 #define SEARCH_ENGINES_BEAUTY_H
 
+#include "../evaluation_context.h"
+#include "../expansion_arena.h"
 #include "../open_list.h"
 #include "../search_engine.h"
 
 #include <memory>
+#include <string>
 #include <vector>
 
 class Evaluator;
@@ -28,6 +31,27 @@ class Beauty : public SearchEngine {
 
     std::shared_ptr<PruningMethod> pruning_method;
 
+    ExpansionArena expansion_arena;
+
+    /*
+      New successors of the current expansion that still have to be
+      evaluated and inserted into the open list. With a thread pool and
+      no path-dependent evaluators, we evaluate them as a batch, otherwise
+      each successor is inserted right away.
+    */
+    struct NewSuccessor {
+        State state;
+        OperatorID op_id;
+        EstimationInfo estimation_info;
+        EvaluationContext eval_context;
+
+        NewSuccessor(const State &state, OperatorID op_id,
+                     const EstimationInfo &estimation_info, int g,
+                     bool is_preferred, SearchStatistics *statistics);
+    };
+    std::vector<NewSuccessor> new_successors;
+    bool batch_evaluation;
+
     // cost relaxation bound
     const int factor_first;
     const int factor_second;
@@ -38,11 +62,22 @@ class Beauty : public SearchEngine {
     void update_f_value_statistics(EvaluationContext &eval_context);
     void reward_progress();
     void perform_end_of_search_estimations(const State &state);
+    void reinsert_open_nodes();
+    void raise_estimated_cost(OperatorID op_id, const EstimationInfo &estimation_info);
+    bool is_new_successor(const State &state) const;
+    void insert_new_successor(const SearchNode &node, NewSuccessor &successor);
+    void insert_new_successors(const SearchNode &node);
 
 protected:
     virtual void initialize() override;
     virtual SearchStatus step() override;
 
+    virtual std::string get_checkpoint_kind() const override;
+    virtual void save_checkpoint(
+        search_checkpoint::CheckpointWriter &writer) const override;
+    virtual bool load_checkpoint(
+        search_checkpoint::CheckpointReader &reader) override;
+
 public:
     explicit Beauty(const options::Options &opts);
     virtual ~Beauty() = default;
@@ -6,10 +6,10 @@
 #include "../option_parser.h"
 #include "../pruning_method.h"
 
-#include "../algorithms/ordered_set.h"
 #include "../task_utils/successor_generator.h"
 
 #include "../utils/logging.h"
+#include "../utils/thread_pool.h"
 
 #include <cassert>
 #include <cstdlib>
@@ -29,7 +29,9 @@ EagerSearch::EagerSearch(const Options &opts)
       f_evaluator(opts.get<shared_ptr<Evaluator>>("f_eval", nullptr)),
       preferred_operator_evaluators(opts.get_list<shared_ptr<Evaluator>>("preferred")),
       lazy_evaluator(opts.get<shared_ptr<Evaluator>>("lazy_evaluator", nullptr)),
-      pruning_method(opts.get<shared_ptr<PruningMethod>>("pruning")) {
+      pruning_method(opts.get<shared_ptr<PruningMethod>>("pruning")),
+      expansion_arena(task_proxy.get_operators().size()),
+      batch_evaluation(false) {
     if (lazy_evaluator && !lazy_evaluator->does_cache_estimates()) {
         cerr << "lazy_evaluator must cache its estimates" << endl;
         utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
@@ -73,6 +75,12 @@ void EagerSearch::initialize() {
 
     path_dependent_evaluators.assign(evals.begin(), evals.end());
 
+    /*
+      Path-dependent evaluators must see the successors in the order in
+      which they are generated, so we only evaluate batches without them.
+    */
+    batch_evaluation = utils::get_thread_pool() && path_dependent_evaluators.empty();
+
     State initial_state = state_registry.get_initial_state();
     for (Evaluator *evaluator : path_dependent_evaluators) {
         evaluator->notify_initial_state(initial_state);
@@ -107,6 +115,7 @@ void EagerSearch::print_statistics() const {
     statistics.print_detailed_statistics();
     search_space.print_statistics();
     pruning_method->print_statistics();
+    expansion_arena.print_statistics();
 }
 
 SearchStatus EagerSearch::step() {
@@ -173,7 +182,8 @@ SearchStatus EagerSearch::step() {
     if (check_goal_and_set_plan(s))
         return SOLVED;
 
-    vector<OperatorID> applicable_ops;
+    expansion_arena.reset();
+    vector<OperatorID> &applicable_ops = expansion_arena.get_applicable_ops();
     successor_generator.generate_applicable_ops(s, applicable_ops);
 
     /*
@@ -184,11 +194,9 @@ SearchStatus EagerSearch::step() {
 
     // This evaluates the expanded state (again) to get preferred ops
     EvaluationContext eval_context(s, node->get_g(), false, &statistics, true);
-    ordered_set::OrderedSet<OperatorID> preferred_operators;
     for (const shared_ptr<Evaluator> &preferred_operator_evaluator : preferred_operator_evaluators) {
-        collect_preferred_operators(eval_context,
-                                    preferred_operator_evaluator.get(),
-                                    preferred_operators);
+        expansion_arena.collect_preferred_operators(
+            eval_context, preferred_operator_evaluator.get());
     }
 
     for (OperatorID op_id : applicable_ops) {
@@ -198,7 +206,11 @@ SearchStatus EagerSearch::step() {
 
         State succ_state = state_registry.get_successor_state(s, op);
         statistics.inc_generated();
-        bool is_preferred = preferred_operators.contains(op_id);
+        bool is_preferred = expansion_arena.is_preferred(op_id);
+
+        // Duplicates within the current batch see the inserted node.
+        if (is_new_successor(succ_state))
+            insert_new_successors(*node);
 
         SearchNode succ_node = search_space.get_node(succ_state);
 
@@ -219,22 +231,10 @@ SearchStatus EagerSearch::step() {
             // TODO: Make this less fragile.
             int succ_g = node->get_g() + get_adjusted_cost(op);
 
-            EvaluationContext succ_eval_context(
-                succ_state, succ_g, is_preferred, &statistics);
-            statistics.inc_evaluated_states();
-
-            if (open_list->is_dead_end(succ_eval_context)) {
-                succ_node.mark_as_dead_end();
-                statistics.inc_dead_ends();
-                continue;
-            }
-            succ_node.open(*node, op, get_adjusted_cost(op));
-
-            open_list->insert(succ_eval_context, succ_state.get_id());
-            if (search_progress.check_progress(succ_eval_context)) {
-                statistics.print_checkpoint_line(succ_node.get_g());
-                reward_progress();
-            }
+            new_successors.emplace_back(
+                succ_state, op_id, succ_g, is_preferred, &statistics);
+            if (!batch_evaluation)
+                insert_new_successors(*node);
         } else if (succ_node.get_g() > node->get_g() + get_adjusted_cost(op)) {
             // We found a new cheapest path to an open or closed state.
             if (reopen_closed_nodes) {
@@ -248,6 +248,8 @@ SearchStatus EagerSearch::step() {
                     */
                     statistics.inc_reopened();
                 }
+                // Keep the order of insertions into the open list.
+                insert_new_successors(*node);
                 succ_node.reopen(*node, op, get_adjusted_cost(op));
 
                 EvaluationContext succ_eval_context(
@@ -279,10 +281,55 @@ SearchStatus EagerSearch::step() {
             }
         }
     }
+    insert_new_successors(*node);
 
     return IN_PROGRESS;
 }
 
+bool EagerSearch::is_new_successor(const State &state) const {
+    for (const NewSuccessor &successor : new_successors) {
+        if (successor.state.get_id() == state.get_id())
+            return true;
+    }
+    return false;
+}
+
+void EagerSearch::insert_new_successor(
+    const SearchNode &node, NewSuccessor &successor) {
+    SearchNode succ_node = search_space.get_node(successor.state);
+    EvaluationContext &succ_eval_context = successor.eval_context;
+    statistics.inc_evaluated_states();
+
+    if (open_list->is_dead_end(succ_eval_context)) {
+        succ_node.mark_as_dead_end();
+        statistics.inc_dead_ends();
+        return;
+    }
+    OperatorProxy op = task_proxy.get_operators()[successor.op_id];
+    succ_node.open(node, op, get_adjusted_cost(op));
+
+    open_list->insert(succ_eval_context, successor.state.get_id());
+    if (search_progress.check_progress(succ_eval_context)) {
+        statistics.print_checkpoint_line(succ_node.get_g());
+        reward_progress();
+    }
+}
+
+void EagerSearch::insert_new_successors(const SearchNode &node) {
+    if (new_successors.empty())
+        return;
+    if (batch_evaluation && new_successors.size() > 1) {
+        vector<EvaluationContext *> eval_contexts;
+        eval_contexts.reserve(new_successors.size());
+        for (NewSuccessor &successor : new_successors)
+            eval_contexts.push_back(&successor.eval_context);
+        open_list->compute_results(eval_contexts);
+    }
+    for (NewSuccessor &successor : new_successors)
+        insert_new_successor(node, successor);
+    new_successors.clear();
+}
+
 void EagerSearch::reward_progress() {
     // Boost the "preferred operator" open lists somewhat whenever
     // one of the heuristics finds a state with a new best h value.
@@ -1,6 +1,8 @@
 #ifndef SEARCH_ENGINES_EAGER_SEARCH_H
 #define SEARCH_ENGINES_EAGER_SEARCH_H
 
+#include "../evaluation_context.h"
+#include "../expansion_arena.h"
 #include "../open_list.h"
 #include "../search_engine.h"
 
@@ -28,9 +30,35 @@ class EagerSearch : public SearchEngine {
 
     std::shared_ptr<PruningMethod> pruning_method;
 
+    ExpansionArena expansion_arena;
+
+    /*
+      New successors of the current expansion that still have to be
+      evaluated and inserted into the open list. With a thread pool and
+      no path-dependent evaluators, we evaluate them as a batch, otherwise
+      each successor is inserted right away.
+    */
+    struct NewSuccessor {
+        State state;
+        OperatorID op_id;
+        EvaluationContext eval_context;
+
+        NewSuccessor(const State &state, OperatorID op_id, int g,
+                     bool is_preferred, SearchStatistics *statistics)
+            : state(state),
+              op_id(op_id),
+              eval_context(state, g, is_preferred, statistics) {
+        }
+    };
+    std::vector<NewSuccessor> new_successors;
+    bool batch_evaluation;
+
     void start_f_value_statistics(EvaluationContext &eval_context);
     void update_f_value_statistics(EvaluationContext &eval_context);
     void reward_progress();
+    bool is_new_successor(const State &state) const;
+    void insert_new_successor(const SearchNode &node, NewSuccessor &successor);
+    void insert_new_successors(const SearchNode &node);
 
 protected:
     virtual void initialize() override;
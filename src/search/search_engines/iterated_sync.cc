@@ -116,6 +116,60 @@ SearchStatus IteratedSync::step() {
     return step_return_value();
 }
 
+void IteratedSync::initialize() {
+    resume_from_checkpoint();
+}
+
+string IteratedSync::get_checkpoint_kind() const {
+    return "iterations";
+}
+
+bool IteratedSync::is_checkpoint_due() const {
+    // Iterations take long, so we save the progress after each of them.
+    return true;
+}
+
+void IteratedSync::save_checkpoint(
+    search_checkpoint::CheckpointWriter &writer) const {
+    writer.write(iter);
+    writer.write(iterated_found_solution);
+    writer.write(target_epsilon);
+    writer.write(best_uncertainty_bound);
+    writer.write(overshoot);
+    writer.write(eta_effective);
+    vector<int> plan_op_ids;
+    if (found_solution()) {
+        for (OperatorID op_id : get_plan()) {
+            plan_op_ids.push_back(op_id.get_index());
+        }
+    }
+    writer.write(found_solution());
+    writer.write_vector(plan_op_ids);
+    writer.write(plan_manager.get_num_previously_generated_plans());
+    statistics.save(writer);
+}
+
+bool IteratedSync::load_checkpoint(search_checkpoint::CheckpointReader &reader) {
+    iter = reader.read<int>();
+    iterated_found_solution = reader.read<bool>();
+    target_epsilon = reader.read<double>();
+    best_uncertainty_bound = reader.read<double>();
+    overshoot = reader.read<double>();
+    eta_effective = reader.read<double>();
+    bool has_plan = reader.read<bool>();
+    vector<int> plan_op_ids = reader.read_vector<int>();
+    if (has_plan) {
+        Plan best_plan;
+        for (int op_id : plan_op_ids) {
+            best_plan.emplace_back(op_id);
+        }
+        set_plan(best_plan);
+    }
+    plan_manager.set_num_previously_generated_plans(reader.read<int>());
+    statistics.load(reader);
+    return true;
+}
+
 SearchStatus IteratedSync::step_return_value() {
     if (iterated_found_solution) {
         utils::g_log << endl << "Best uncertainty bound so far: " << best_uncertainty_bound << endl;
@@ -37,8 +37,16 @@ class IteratedSync : public SearchEngine {
     void update_overshoot();
     SearchStatus step_return_value();
 
+    virtual void initialize() override;
     virtual SearchStatus step() override;
 
+    virtual std::string get_checkpoint_kind() const override;
+    virtual bool is_checkpoint_due() const override;
+    virtual void save_checkpoint(
+        search_checkpoint::CheckpointWriter &writer) const override;
+    virtual bool load_checkpoint(
+        search_checkpoint::CheckpointReader &reader) override;
+
 public:
     IteratedSync(const options::Options &opts, options::Registry &registry,
                    const options::Predefinitions &predefinitions);
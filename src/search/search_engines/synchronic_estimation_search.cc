@@ -7,7 +7,6 @@
 #include "../option_parser.h"
 #include "../pruning_method.h"
 
-#include "../algorithms/ordered_set.h"
 #include "../task_utils/successor_generator.h"
 #include "../utils/logging.h"
 
@@ -31,6 +30,7 @@ SynchronicEstimationSearch::SynchronicEstimationSearch(const Options &opts)
       preferred_operator_evaluators(opts.get_list<shared_ptr<Evaluator>>("preferred")),
       lazy_evaluator(opts.get<shared_ptr<Evaluator>>("lazy_evaluator", nullptr)),
       pruning_method(opts.get<shared_ptr<PruningMethod>>("pruning")),
+      expansion_arena(task_proxy.get_operators().size()),
       epsilon(opts.get<double>("epsilon")),
       edge_estimation_avg_time(opts.get<int>("edge_estimation_avg_time")),
       edge_estimation_time_interval(opts.get<int>("edge_estimation_time_interval")),
@@ -84,6 +84,16 @@ void SynchronicEstimationSearch::initialize() {
 
     path_dependent_evaluators.assign(evals.begin(), evals.end());
 
+    if (search_checkpoint::checkpoints_are_enabled() &&
+        !path_dependent_evaluators.empty()) {
+        utils::g_log << "Checkpoints are not supported with path-dependent "
+                     << "evaluators and will not be written." << endl;
+    }
+    if (resume_from_checkpoint()) {
+        pruning_method->initialize(task);
+        return;
+    }
+
     State initial_state = state_registry.get_initial_state();
     for (Evaluator *evaluator : path_dependent_evaluators) {
         evaluator->notify_initial_state(initial_state);
@@ -114,10 +124,54 @@ void SynchronicEstimationSearch::initialize() {
     pruning_method->initialize(task);
 }
 
+string SynchronicEstimationSearch::get_checkpoint_kind() const {
+    /*
+      The information of path-dependent evaluators cannot be restored, so
+      we only support checkpoints without them.
+    */
+    return path_dependent_evaluators.empty() ? "search" : "";
+}
+
+void SynchronicEstimationSearch::save_checkpoint(
+    search_checkpoint::CheckpointWriter &writer) const {
+    save_search_space_checkpoint(writer);
+}
+
+bool SynchronicEstimationSearch::load_checkpoint(search_checkpoint::CheckpointReader &reader) {
+    if (!load_search_space_checkpoint(reader)) {
+        return false;
+    }
+    reinsert_open_nodes();
+    return true;
+}
+
+/*
+  Instead of storing the open list, we rebuild it from the open nodes of
+  the restored search space. This evaluates all open states once more but
+  works for all open lists. Note that we do not know anymore whether the
+  states were reached by preferred operators.
+*/
+void SynchronicEstimationSearch::reinsert_open_nodes() {
+    int num_open_nodes = 0;
+    for (StateID id : state_registry) {
+        State state = state_registry.lookup_state(id);
+        SearchNode node = search_space.get_node(state);
+        if (!node.is_open())
+            continue;
+        EvaluationContext eval_context(state, node.get_g(), false, &statistics);
+        if (!open_list->is_dead_end(eval_context)) {
+            open_list->insert(eval_context, id);
+            ++num_open_nodes;
+        }
+    }
+    utils::g_log << "Reinserted " << num_open_nodes << " open states." << endl;
+}
+
 void SynchronicEstimationSearch::print_statistics() const {
     statistics.print_detailed_statistics();
     search_space.print_statistics();
     pruning_method->print_statistics();
+    expansion_arena.print_statistics();
 }
 
 SearchStatus SynchronicEstimationSearch::step() {
@@ -205,7 +259,8 @@ SearchStatus SynchronicEstimationSearch::step() {
     }
     // statistics.print_checkpoint_line(node->get_g()); //TODO: delete
 
-    vector<OperatorID> applicable_ops;
+    expansion_arena.reset();
+    vector<OperatorID> &applicable_ops = expansion_arena.get_applicable_ops();
     successor_generator.generate_applicable_ops(s, applicable_ops);
 
     /*
@@ -216,11 +271,9 @@ SearchStatus SynchronicEstimationSearch::step() {
 
     // This evaluates the expanded state (again) to get preferred ops
     EvaluationContext eval_context(s, node->get_g(), false, &statistics, true);
-    ordered_set::OrderedSet<OperatorID> preferred_operators;
     for (const shared_ptr<Evaluator> &preferred_operator_evaluator : preferred_operator_evaluators) {
-        collect_preferred_operators(eval_context,
-                                    preferred_operator_evaluator.get(),
-                                    preferred_operators);
+        expansion_arena.collect_preferred_operators(
+            eval_context, preferred_operator_evaluator.get());
     }
 
     for (OperatorID op_id : applicable_ops) {
@@ -230,7 +283,7 @@ SearchStatus SynchronicEstimationSearch::step() {
 
         State succ_state = state_registry.get_successor_state(s, op);
         statistics.inc_generated();
-        bool is_preferred = preferred_operators.contains(op_id);
+        bool is_preferred = expansion_arena.is_preferred(op_id);
 
         SearchNode succ_node = search_space.get_node(succ_state);
 
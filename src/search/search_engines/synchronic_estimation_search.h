@@ -1,10 +1,12 @@
 #ifndef SEARCH_ENGINES_SYNCHRONIC_ESTIMATION_SEARCH_H
 #define SEARCH_ENGINES_SYNCHRONIC_ESTIMATION_SEARCH_H
 
+#include "../expansion_arena.h"
 #include "../open_list.h"
 #include "../search_engine.h"
 
 #include <memory>
+#include <string>
 #include <vector>
 
 class Evaluator;
@@ -28,6 +30,8 @@ class SynchronicEstimationSearch : public SearchEngine {
 
     std::shared_ptr<PruningMethod> pruning_method;
 
+    ExpansionArena expansion_arena;
+
     // cost relaxation bound
     const double epsilon;
     const int edge_estimation_avg_time;
@@ -41,11 +45,18 @@ class SynchronicEstimationSearch : public SearchEngine {
     void update_f_value_statistics(EvaluationContext &eval_context);
     void reward_progress();
     void perform_end_of_search_estimations(const State &state);
+    void reinsert_open_nodes();
 
 protected:
     virtual void initialize() override;
     virtual SearchStatus step() override;
 
+    virtual std::string get_checkpoint_kind() const override;
+    virtual void save_checkpoint(
+        search_checkpoint::CheckpointWriter &writer) const override;
+    virtual bool load_checkpoint(
+        search_checkpoint::CheckpointReader &reader) override;
+
 public:
     explicit SynchronicEstimationSearch(const options::Options &opts);
     virtual ~SynchronicEstimationSearch() = default;
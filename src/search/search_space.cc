@@ -1,12 +1,15 @@
 #include "search_space.h"
 
+#include "search_checkpoint.h"
 #include "search_node_info.h"
 #include "task_proxy.h"
 
 #include "task_utils/task_properties.h"
 #include "utils/logging.h"
+#include "utils/system.h"
 
 #include <cassert>
+#include <cstring>
 
 using namespace std;
 
@@ -242,3 +245,29 @@ void SearchSpace::dump(const TaskProxy &task_proxy) const {
 void SearchSpace::print_statistics() const {
     state_registry.print_statistics();
 }
+
+/*
+  SearchNodeInfo only consists of plain values (StateID merely lacks the
+  trivial destructor needed to formally be trivially copyable), so we
+  store its raw bytes.
+*/
+void SearchSpace::save(search_checkpoint::CheckpointWriter &writer) const {
+    writer.write<int64_t>(state_registry.size());
+    for (StateID id : state_registry) {
+        State state = state_registry.lookup_state(id);
+        writer.write_bytes(&search_node_infos[state], sizeof(SearchNodeInfo));
+    }
+}
+
+void SearchSpace::load(search_checkpoint::CheckpointReader &reader) {
+    size_t num_states = reader.read<int64_t>();
+    if (num_states != state_registry.size()) {
+        cerr << "Checkpoint contains an inconsistent search space." << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+    for (StateID id : state_registry) {
+        State state = state_registry.lookup_state(id);
+        memcpy(static_cast<void *>(&search_node_infos[state]),
+               reader.read_bytes(sizeof(SearchNodeInfo)), sizeof(SearchNodeInfo));
+    }
+}
@@ -7,6 +7,11 @@
 
 #include <vector>
 
+namespace search_checkpoint {
+class CheckpointReader;
+class CheckpointWriter;
+}
+
 class OperatorProxy;
 class State;
 class TaskProxy;
@@ -72,7 +77,15 @@ public:
 
     void dump(const TaskProxy &task_proxy) const;
     void print_statistics() const;
-    
+
+    /*
+      Store and restore the search node information of all states in the
+      underlying registry. The registry must be restored before the search
+      space.
+    */
+    void save(search_checkpoint::CheckpointWriter &writer) const;
+    void load(search_checkpoint::CheckpointReader &reader);
+
     void set_estimation_info_based_on_edge(EstimationInfo &estimation_info,
                                            const SearchNode &parent_node,
                                            const SearchNode &curr_node);
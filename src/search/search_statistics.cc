@@ -1,5 +1,7 @@
 #include "search_statistics.h"
 
+#include "search_checkpoint.h"
+
 #include "utils/logging.h"
 #include "utils/timer.h"
 #include "utils/system.h"
@@ -101,3 +103,43 @@ void SearchStatistics::print_detailed_statistics() const {
                      << lastjump_generated_states << " state(s)." << endl;
     }
 }
+
+void SearchStatistics::save(search_checkpoint::CheckpointWriter &writer) const {
+    vector<int> counters = {
+        edges, expanded_states, evaluated_states, pruned_states,
+        estimated_edges, evaluations, estimations, l1_estimations,
+        l2_estimations, l3_estimations, generated_states, reopened_states,
+        dead_end_states, generated_ops, lastjump_f_value,
+        lastjump_expanded_states, lastjump_reopened_states,
+        lastjump_evaluated_states, lastjump_estimated_edges,
+        lastjump_generated_states};
+    writer.write_vector(counters);
+}
+
+void SearchStatistics::load(search_checkpoint::CheckpointReader &reader) {
+    vector<int> counters = reader.read_vector<int>();
+    if (counters.size() != 20) {
+        cerr << "Checkpoint contains invalid search statistics." << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+    edges = counters[0];
+    expanded_states = counters[1];
+    evaluated_states = counters[2];
+    pruned_states = counters[3];
+    estimated_edges = counters[4];
+    evaluations = counters[5];
+    estimations = counters[6];
+    l1_estimations = counters[7];
+    l2_estimations = counters[8];
+    l3_estimations = counters[9];
+    generated_states = counters[10];
+    reopened_states = counters[11];
+    dead_end_states = counters[12];
+    generated_ops = counters[13];
+    lastjump_f_value = counters[14];
+    lastjump_expanded_states = counters[15];
+    lastjump_reopened_states = counters[16];
+    lastjump_evaluated_states = counters[17];
+    lastjump_estimated_edges = counters[18];
+    lastjump_generated_states = counters[19];
+}
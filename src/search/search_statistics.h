@@ -9,6 +9,11 @@
   methods.
 */
 
+namespace search_checkpoint {
+class CheckpointReader;
+class CheckpointWriter;
+}
+
 namespace utils {
 enum class Verbosity;
 }
@@ -99,6 +104,10 @@ public:
     // output
     void print_basic_statistics() const;
     void print_detailed_statistics() const;
+
+    // Store and restore all counters in search checkpoints.
+    void save(search_checkpoint::CheckpointWriter &writer) const;
+    void load(search_checkpoint::CheckpointReader &reader);
 };
 
 #endif
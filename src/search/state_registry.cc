@@ -1,10 +1,14 @@
 #include "state_registry.h"
 
 #include "per_state_information.h"
+#include "search_checkpoint.h"
 #include "task_proxy.h"
 
 #include "task_utils/task_properties.h"
 #include "utils/logging.h"
+#include "utils/system.h"
+
+#include <cstring>
 
 using namespace std;
 
@@ -107,3 +111,29 @@ void StateRegistry::print_statistics() const {
     utils::g_log << "Number of registered states: " << size() << endl;
     registered_states.print_statistics();
 }
+
+void StateRegistry::save(search_checkpoint::CheckpointWriter &writer) const {
+    int num_bins = get_bins_per_state();
+    writer.write<int64_t>(size());
+    for (size_t id = 0; id < size(); ++id) {
+        writer.write_bytes(state_data_pool[id], num_bins * sizeof(PackedStateBin));
+    }
+}
+
+void StateRegistry::load(search_checkpoint::CheckpointReader &reader) {
+    assert(size() == 0);
+    int num_bins = get_bins_per_state();
+    size_t num_states = reader.read<int64_t>();
+    unique_ptr<PackedStateBin[]> buffer(new PackedStateBin[num_bins]);
+    for (size_t id = 0; id < num_states; ++id) {
+        // The snapshot data is not necessarily aligned.
+        memcpy(buffer.get(), reader.read_bytes(num_bins * sizeof(PackedStateBin)),
+               num_bins * sizeof(PackedStateBin));
+        state_data_pool.push_back(buffer.get());
+        StateID state_id = insert_id_or_pop_state();
+        if (state_id.value != static_cast<int>(id)) {
+            cerr << "Checkpoint contains duplicate states." << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+        }
+    }
+}
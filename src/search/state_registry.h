@@ -109,6 +109,11 @@ namespace int_packer {
 class IntPacker;
 }
 
+namespace search_checkpoint {
+class CheckpointReader;
+class CheckpointWriter;
+}
+
 using PackedStateBin = int_packer::IntPacker::Bin;
 
 
@@ -214,6 +219,14 @@ public:
 
     void print_statistics() const;
 
+    /*
+      Store the packed data of all registered states in a search checkpoint
+      and register them again in the same order when loading it, so that
+      all state IDs stay valid. Loading requires an empty registry.
+    */
+    void save(search_checkpoint::CheckpointWriter &writer) const;
+    void load(search_checkpoint::CheckpointReader &reader);
+
     class const_iterator : public std::iterator<
                                std::forward_iterator_tag, StateID> {
         /*
@@ -0,0 +1,82 @@
+#include "fact_tuple_index.h"
+
+#include "../utils/system.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+
+using namespace std;
+using utils::ExitCode;
+
+namespace fact_tuple_index {
+static const int64_t MAX_RANK = numeric_limits<int>::max();
+
+static int64_t saturated_sum(int64_t a, int64_t b) {
+    return min(a + b, MAX_RANK + 1);
+}
+
+static void exit_too_many_ranks(int max_size) {
+    cerr << "Too many fact sets of size at most " << max_size
+         << " to index them with int." << endl;
+    utils::exit_with(ExitCode::SEARCH_OUT_OF_MEMORY);
+}
+
+FactTupleIndex::FactTupleIndex(const TaskProxy &task_proxy, int max_size)
+    : max_size(max_size) {
+    assert(max_size >= 1);
+    VariablesProxy variables = task_proxy.get_variables();
+    fact_offsets.reserve(variables.size());
+    for (VariableProxy var : variables) {
+        fact_offsets.push_back(facts.size());
+        for (int value = 0; value < var.get_domain_size(); ++value)
+            facts.emplace_back(var.get_id(), value);
+    }
+    int num_facts = facts.size();
+
+    /*
+      Compute the binomial coefficients with Pascal's rule. They are
+      saturated at MAX_RANK + 1, which is enough to detect overflows since
+      every C(f, k) with f < num_facts is bounded by C(num_facts, k).
+    */
+    vector<int64_t> previous_row(num_facts + 1, 1);
+    binomial_coefficients.resize(max_size + 1);
+    first_ranks.resize(max_size + 2);
+    first_ranks[1] = 0;
+    int64_t num_ranks = 0;
+    for (int k = 1; k <= max_size; ++k) {
+        vector<int64_t> row(num_facts + 1, 0);
+        for (int f = 1; f <= num_facts; ++f)
+            row[f] = saturated_sum(row[f - 1], previous_row[f - 1]);
+        num_ranks = saturated_sum(num_ranks, row[num_facts]);
+        if (num_ranks > MAX_RANK)
+            exit_too_many_ranks(max_size);
+        first_ranks[k + 1] = num_ranks;
+        binomial_coefficients[k].assign(row.begin(), row.end() - 1);
+        previous_row.swap(row);
+    }
+}
+
+int FactTupleIndex::get_rank(const vector<int> &fact_ids) const {
+    int size = fact_ids.size();
+    assert(size >= 1 && size <= max_size);
+    int rank = first_ranks[size];
+    for (int i = 0; i < size; ++i) {
+        assert(i == 0 || fact_ids[i - 1] < fact_ids[i]);
+        rank += binomial_coefficients[i + 1][fact_ids[i]];
+    }
+    return rank;
+}
+
+int FactTupleIndex::get_rank(const vector<FactPair> &facts) const {
+    int size = facts.size();
+    assert(size >= 1 && size <= max_size);
+    int rank = first_ranks[size];
+    for (int i = 0; i < size; ++i) {
+        assert(i == 0 || facts[i - 1] < facts[i]);
+        rank += binomial_coefficients[i + 1][get_fact_id(facts[i])];
+    }
+    return rank;
+}
+}
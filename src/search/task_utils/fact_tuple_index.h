@@ -0,0 +1,78 @@
+#ifndef TASK_UTILS_FACT_TUPLE_INDEX_H
+#define TASK_UTILS_FACT_TUPLE_INDEX_H
+
+#include "../task_proxy.h"
+
+#include <cassert>
+#include <vector>
+
+namespace fact_tuple_index {
+/*
+  Perfect hash function for all sets of at most max_size facts.
+
+  Facts are numbered consecutively by variable and value. A set of k facts
+  with IDs f_1 < ... < f_k is ranked in the combinatorial number system as
+  C(f_1, 1) + ... + C(f_k, k), offset by the number of sets with fewer than
+  k facts. The ranks of all sets of size k form the dense interval
+  [get_first_rank(k), get_first_rank(k + 1)), so values for all sets can be
+  stored in one flat array with get_num_ranks() entries.
+
+  Sets containing two facts of the same variable have ranks as well. Users
+  that only deal with consistent sets simply never access these entries.
+*/
+class FactTupleIndex {
+    const int max_size;
+    std::vector<int> fact_offsets;
+    std::vector<FactPair> facts;
+    // binomial_coefficients[k][f] = C(f, k) for 1 <= k <= max_size.
+    std::vector<std::vector<int>> binomial_coefficients;
+    // first_ranks[k] is the smallest rank of a set of size k.
+    std::vector<int> first_ranks;
+
+public:
+    FactTupleIndex(const TaskProxy &task_proxy, int max_size);
+
+    int get_max_size() const {
+        return max_size;
+    }
+
+    int get_num_facts() const {
+        return facts.size();
+    }
+
+    int get_num_ranks() const {
+        return first_ranks[max_size + 1];
+    }
+
+    int get_fact_id(const FactPair &fact) const {
+        return fact_offsets[fact.var] + fact.value;
+    }
+
+    const FactPair &get_fact(int fact_id) const {
+        return facts[fact_id];
+    }
+
+    int get_first_rank(int size) const {
+        assert(size >= 1 && size <= max_size + 1);
+        return first_ranks[size];
+    }
+
+    /*
+      Contribution of the fact with the given ID to the rank of a set in
+      which it is the position-th smallest fact (counting from 1). Callers
+      that enumerate subsets recursively can use this to compute ranks
+      without materializing the subsets.
+    */
+    int get_rank_summand(int fact_id, int position) const {
+        assert(position >= 1 && position <= max_size);
+        return binomial_coefficients[position][fact_id];
+    }
+
+    // The fact IDs must be strictly increasing.
+    int get_rank(const std::vector<int> &fact_ids) const;
+    // The facts must be sorted and pairwise distinct.
+    int get_rank(const std::vector<FactPair> &facts) const;
+};
+}
+
+#endif
@@ -0,0 +1,519 @@
+#include "binary_root_task.h"
+
+#include "../utils/mapped_file.h"
+#include "../utils/system.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+using namespace std;
+using utils::ExitCode;
+
+namespace tasks {
+const char BINARY_TASK_MAGIC[8] = {'\x89', 'F', 'D', 'T', 'A', 'S', 'K', '\n'};
+static const int BINARY_TASK_VERSION = 1;
+static const int BYTE_ORDER_MARK = 0x01020304;
+
+bool has_binary_task_magic(const char *data, size_t size) {
+    return size >= sizeof(BINARY_TASK_MAGIC) &&
+           memcmp(data, BINARY_TASK_MAGIC, sizeof(BINARY_TASK_MAGIC)) == 0;
+}
+
+static void write_int(ostream &out, int value) {
+    out.write(reinterpret_cast<const char *>(&value), sizeof(int));
+}
+
+static void write_array(ostream &out, const vector<int> &values) {
+    write_int(out, values.size());
+    out.write(reinterpret_cast<const char *>(values.data()),
+              values.size() * sizeof(int));
+}
+
+static void add_fact(vector<int> &values, const FactPair &fact) {
+    values.push_back(fact.var);
+    values.push_back(fact.value);
+}
+
+/*
+  Strings are stored as an array of byte offsets and an array holding
+  the characters of all strings, padded to a multiple of sizeof(int).
+*/
+static void write_strings(ostream &out, const vector<string> &strings) {
+    vector<int> offsets;
+    offsets.reserve(strings.size() + 1);
+    string chars;
+    for (const string &s : strings) {
+        offsets.push_back(chars.size());
+        chars += s;
+    }
+    offsets.push_back(chars.size());
+    write_array(out, offsets);
+    chars.resize((chars.size() + sizeof(int) - 1) / sizeof(int) * sizeof(int), '\0');
+    write_int(out, chars.size() / sizeof(int));
+    out.write(chars.data(), chars.size());
+}
+
+static void write_actions(
+    ostream &out, const AbstractTask &task, bool is_axiom) {
+    int num_actions = is_axiom ? task.get_num_axioms() : task.get_num_operators();
+    vector<int> costs;
+    vector<int> precondition_offsets;
+    vector<int> preconditions;
+    vector<int> effect_offsets;
+    vector<int> effects;
+    vector<int> effect_condition_offsets;
+    vector<int> effect_conditions;
+    for (int op = 0; op < num_actions; ++op) {
+        costs.push_back(task.get_operator_cost(op, is_axiom));
+        precondition_offsets.push_back(preconditions.size() / 2);
+        int num_preconditions = task.get_num_operator_preconditions(op, is_axiom);
+        for (int pre = 0; pre < num_preconditions; ++pre) {
+            add_fact(preconditions, task.get_operator_precondition(op, pre, is_axiom));
+        }
+        effect_offsets.push_back(effects.size() / 2);
+        int num_effects = task.get_num_operator_effects(op, is_axiom);
+        for (int eff = 0; eff < num_effects; ++eff) {
+            add_fact(effects, task.get_operator_effect(op, eff, is_axiom));
+            effect_condition_offsets.push_back(effect_conditions.size() / 2);
+            int num_conditions =
+                task.get_num_operator_effect_conditions(op, eff, is_axiom);
+            for (int cond = 0; cond < num_conditions; ++cond) {
+                add_fact(effect_conditions, task.get_operator_effect_condition(
+                             op, eff, cond, is_axiom));
+            }
+        }
+    }
+    precondition_offsets.push_back(preconditions.size() / 2);
+    effect_offsets.push_back(effects.size() / 2);
+    effect_condition_offsets.push_back(effect_conditions.size() / 2);
+
+    write_array(out, costs);
+    write_array(out, precondition_offsets);
+    write_array(out, preconditions);
+    write_array(out, effect_offsets);
+    write_array(out, effects);
+    write_array(out, effect_condition_offsets);
+    write_array(out, effect_conditions);
+}
+
+void write_binary_task(
+    const AbstractTask &task,
+    const vector<vector<vector<FactPair>>> &mutexes,
+    ostream &out) {
+    out.write(BINARY_TASK_MAGIC, sizeof(BINARY_TASK_MAGIC));
+    write_int(out, BINARY_TASK_VERSION);
+    write_int(out, BYTE_ORDER_MARK);
+
+    int num_variables = task.get_num_variables();
+    vector<int> domain_sizes;
+    vector<int> axiom_layers;
+    vector<int> axiom_default_values;
+    vector<string> variable_names;
+    vector<string> fact_names;
+    vector<int> mutex_offsets;
+    vector<int> mutex_facts;
+    for (int var = 0; var < num_variables; ++var) {
+        int domain_size = task.get_variable_domain_size(var);
+        domain_sizes.push_back(domain_size);
+        axiom_layers.push_back(task.get_variable_axiom_layer(var));
+        axiom_default_values.push_back(task.get_variable_default_axiom_value(var));
+        variable_names.push_back(task.get_variable_name(var));
+        for (int value = 0; value < domain_size; ++value) {
+            fact_names.push_back(task.get_fact_name(FactPair(var, value)));
+            mutex_offsets.push_back(mutex_facts.size() / 2);
+            vector<FactPair> fact_mutexes = mutexes[var][value];
+            sort(fact_mutexes.begin(), fact_mutexes.end());
+            for (const FactPair &fact : fact_mutexes) {
+                add_fact(mutex_facts, fact);
+            }
+        }
+    }
+    mutex_offsets.push_back(mutex_facts.size() / 2);
+
+    vector<int> goals;
+    for (int i = 0; i < task.get_num_goals(); ++i) {
+        add_fact(goals, task.get_goal_fact(i));
+    }
+
+    vector<string> operator_names;
+    for (int op = 0; op < task.get_num_operators(); ++op) {
+        operator_names.push_back(task.get_operator_name(op, false));
+    }
+
+    write_array(out, domain_sizes);
+    write_array(out, axiom_layers);
+    write_array(out, axiom_default_values);
+    write_array(out, task.get_initial_state_values());
+    write_strings(out, variable_names);
+    write_strings(out, fact_names);
+    write_array(out, mutex_offsets);
+    write_array(out, mutex_facts);
+    write_array(out, goals);
+    write_actions(out, task, false);
+    write_strings(out, operator_names);
+    write_actions(out, task, true);
+}
+
+
+static void exit_with_invalid_task(const string &reason) {
+    cerr << "Invalid binary task: " << reason << endl;
+    utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+}
+
+namespace {
+class ArrayReader {
+    const char *data;
+    size_t size;
+    size_t pos;
+public:
+    ArrayReader(const char *data, size_t size, size_t pos)
+        : data(data), size(size), pos(pos) {
+    }
+
+    int read_int() {
+        if (size - pos < sizeof(int)) {
+            exit_with_invalid_task("file is truncated");
+        }
+        int value;
+        memcpy(&value, data + pos, sizeof(int));
+        pos += sizeof(int);
+        return value;
+    }
+
+    template<typename ArrayType>
+    ArrayType read_array(int expected_size = -1) {
+        int num_ints = read_int();
+        if (num_ints < 0 || (size - pos) / sizeof(int) < static_cast<size_t>(num_ints)) {
+            exit_with_invalid_task("file is truncated");
+        }
+        if (expected_size != -1 && num_ints != expected_size) {
+            exit_with_invalid_task("unexpected array size");
+        }
+        ArrayType array;
+        array.data = reinterpret_cast<const int *>(data + pos);
+        array.size = num_ints;
+        pos += num_ints * sizeof(int);
+        return array;
+    }
+
+    bool at_end() const {
+        return pos == size;
+    }
+};
+}
+
+BinaryRootTask::BinaryRootTask(unique_ptr<utils::MappedFile> file_)
+    : file(move(file_)),
+      data(file->get_data()),
+      size(file->get_size()) {
+    if (reinterpret_cast<uintptr_t>(data) % alignof(int) != 0) {
+        // The arrays are accessed in place, so they must be aligned.
+        buffer.assign(data, data + size);
+        file = nullptr;
+        data = buffer.data();
+    }
+    load();
+}
+
+BinaryRootTask::BinaryRootTask(vector<char> &&buffer_)
+    : buffer(move(buffer_)),
+      data(buffer.data()),
+      size(buffer.size()) {
+    load();
+}
+
+BinaryRootTask::~BinaryRootTask() {
+}
+
+static void check_offsets(const char *name, const int *offsets, int num_offsets,
+                          int num_entries) {
+    assert(num_offsets > 0);
+    if (offsets[0] != 0 || offsets[num_offsets - 1] != num_entries) {
+        exit_with_invalid_task(string("invalid ") + name + " offsets");
+    }
+    for (int i = 1; i < num_offsets; ++i) {
+        if (offsets[i] < offsets[i - 1]) {
+            exit_with_invalid_task(string("invalid ") + name + " offsets");
+        }
+    }
+}
+
+void BinaryRootTask::load() {
+    if (!has_binary_task_magic(data, size)) {
+        exit_with_invalid_task("missing magic number");
+    }
+    ArrayReader reader(data, size, sizeof(BINARY_TASK_MAGIC));
+    if (reader.read_int() != BINARY_TASK_VERSION) {
+        exit_with_invalid_task("unsupported version");
+    }
+    if (reader.read_int() != BYTE_ORDER_MARK) {
+        exit_with_invalid_task("file was written on a machine with a different byte order");
+    }
+
+    domain_sizes = reader.read_array<Array>();
+    int num_variables = domain_sizes.size;
+    axiom_layers = reader.read_array<Array>(num_variables);
+    axiom_default_values = reader.read_array<Array>(num_variables);
+    initial_state_values = reader.read_array<Array>(num_variables);
+
+    fact_offsets.reserve(num_variables);
+    int num_facts = 0;
+    for (int var = 0; var < num_variables; ++var) {
+        if (domain_sizes[var] <= 0) {
+            exit_with_invalid_task("invalid domain size");
+        }
+        fact_offsets.push_back(num_facts);
+        num_facts += domain_sizes[var];
+        int init_value = initial_state_values[var];
+        int default_value = axiom_default_values[var];
+        if (init_value < 0 || init_value >= domain_sizes[var] ||
+            default_value < 0 || default_value >= domain_sizes[var]) {
+            exit_with_invalid_task("invalid initial state");
+        }
+    }
+
+    auto check_facts = [&](const Array &facts) {
+            if (facts.size % 2 != 0) {
+                exit_with_invalid_task("invalid fact array");
+            }
+            for (int i = 0; i < facts.size / 2; ++i) {
+                FactPair fact = facts.get_fact(i);
+                if (fact.var < 0 || fact.var >= num_variables ||
+                    fact.value < 0 || fact.value >= domain_sizes[fact.var]) {
+                    exit_with_invalid_task("invalid fact");
+                }
+            }
+        };
+
+    auto read_strings = [&](Array &offsets, Array &chars, int num_strings) {
+            offsets = reader.read_array<Array>(num_strings + 1);
+            chars = reader.read_array<Array>();
+            check_offsets("string", offsets.data, offsets.size, offsets[num_strings]);
+            if (static_cast<size_t>(offsets[num_strings]) > chars.size * sizeof(int)) {
+                exit_with_invalid_task("invalid string table");
+            }
+        };
+
+    auto read_actions = [&](Actions &actions) {
+            actions.costs = reader.read_array<Array>();
+            int num_actions = actions.costs.size;
+            for (int i = 0; i < num_actions; ++i) {
+                if (actions.costs[i] < 0) {
+                    exit_with_invalid_task("negative operator cost");
+                }
+            }
+            actions.precondition_offsets = reader.read_array<Array>(num_actions + 1);
+            actions.preconditions = reader.read_array<Array>();
+            check_facts(actions.preconditions);
+            check_offsets("precondition", actions.precondition_offsets.data,
+                          num_actions + 1, actions.preconditions.size / 2);
+            actions.effect_offsets = reader.read_array<Array>(num_actions + 1);
+            actions.effects = reader.read_array<Array>();
+            check_facts(actions.effects);
+            int num_effects = actions.effects.size / 2;
+            check_offsets("effect", actions.effect_offsets.data,
+                          num_actions + 1, num_effects);
+            actions.effect_condition_offsets = reader.read_array<Array>(num_effects + 1);
+            actions.effect_conditions = reader.read_array<Array>();
+            check_facts(actions.effect_conditions);
+            check_offsets("effect condition", actions.effect_condition_offsets.data,
+                          num_effects + 1, actions.effect_conditions.size / 2);
+        };
+
+    read_strings(variable_name_offsets, variable_names, num_variables);
+    read_strings(fact_name_offsets, fact_names, num_facts);
+    mutex_offsets = reader.read_array<Array>(num_facts + 1);
+    mutexes = reader.read_array<Array>();
+    check_facts(mutexes);
+    check_offsets("mutex", mutex_offsets.data, num_facts + 1, mutexes.size / 2);
+    goals = reader.read_array<Array>();
+    check_facts(goals);
+    if (goals.size == 0) {
+        cerr << "Task has no goal condition!" << endl;
+        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    }
+    read_actions(operators);
+    read_strings(operator_name_offsets, operator_names, operators.costs.size);
+    read_actions(axioms);
+    if (!reader.at_end()) {
+        exit_with_invalid_task("unexpected data at end of file");
+    }
+}
+
+void BinaryRootTask::write(ostream &out) const {
+    out.write(data, size);
+}
+
+const BinaryRootTask::Actions &BinaryRootTask::get_actions(bool is_axiom) const {
+    return is_axiom ? axioms : operators;
+}
+
+int BinaryRootTask::get_effect_index(
+    int op_index, int eff_index, bool is_axiom) const {
+    const Actions &actions = get_actions(is_axiom);
+    assert(op_index >= 0 && op_index < actions.costs.size);
+    int index = actions.effect_offsets[op_index] + eff_index;
+    assert(eff_index >= 0 && index < actions.effect_offsets[op_index + 1]);
+    return index;
+}
+
+static string get_string(const int *offsets, const int *chars, int index) {
+    const char *begin = reinterpret_cast<const char *>(chars) + offsets[index];
+    return string(begin, offsets[index + 1] - offsets[index]);
+}
+
+int BinaryRootTask::get_num_variables() const {
+    return domain_sizes.size;
+}
+
+string BinaryRootTask::get_variable_name(int var) const {
+    assert(var >= 0 && var < domain_sizes.size);
+    return get_string(variable_name_offsets.data, variable_names.data, var);
+}
+
+int BinaryRootTask::get_variable_domain_size(int var) const {
+    assert(var >= 0 && var < domain_sizes.size);
+    return domain_sizes[var];
+}
+
+int BinaryRootTask::get_variable_axiom_layer(int var) const {
+    assert(var >= 0 && var < domain_sizes.size);
+    return axiom_layers[var];
+}
+
+int BinaryRootTask::get_variable_default_axiom_value(int var) const {
+    assert(var >= 0 && var < domain_sizes.size);
+    return axiom_default_values[var];
+}
+
+string BinaryRootTask::get_fact_name(const FactPair &fact) const {
+    assert(fact.value >= 0 && fact.value < get_variable_domain_size(fact.var));
+    return get_string(fact_name_offsets.data, fact_names.data,
+                      fact_offsets[fact.var] + fact.value);
+}
+
+bool BinaryRootTask::are_facts_mutex(
+    const FactPair &fact1, const FactPair &fact2) const {
+    if (fact1.var == fact2.var) {
+        // Same variable: mutex iff different value.
+        return fact1.value != fact2.value;
+    }
+    assert(fact1.value >= 0 && fact1.value < get_variable_domain_size(fact1.var));
+    int fact_id = fact_offsets[fact1.var] + fact1.value;
+    // The mutexes of each fact are sorted, so we can use binary search.
+    int lo = mutex_offsets[fact_id];
+    int hi = mutex_offsets[fact_id + 1];
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        FactPair fact = mutexes.get_fact(mid);
+        if (fact == fact2) {
+            return true;
+        } else if (fact < fact2) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return false;
+}
+
+int BinaryRootTask::get_operator_cost(int index, bool is_axiom) const {
+    const Actions &actions = get_actions(is_axiom);
+    assert(index >= 0 && index < actions.costs.size);
+    return actions.costs[index];
+}
+
+string BinaryRootTask::get_operator_name(int index, bool is_axiom) const {
+    if (is_axiom) {
+        return "<axiom>";
+    }
+    assert(index >= 0 && index < operators.costs.size);
+    return get_string(operator_name_offsets.data, operator_names.data, index);
+}
+
+int BinaryRootTask::get_num_operators() const {
+    return operators.costs.size;
+}
+
+int BinaryRootTask::get_num_operator_preconditions(int index, bool is_axiom) const {
+    const Actions &actions = get_actions(is_axiom);
+    assert(index >= 0 && index < actions.costs.size);
+    return actions.precondition_offsets[index + 1] -
+           actions.precondition_offsets[index];
+}
+
+FactPair BinaryRootTask::get_operator_precondition(
+    int op_index, int fact_index, bool is_axiom) const {
+    const Actions &actions = get_actions(is_axiom);
+    assert(fact_index >= 0 &&
+           fact_index < get_num_operator_preconditions(op_index, is_axiom));
+    return actions.preconditions.get_fact(
+        actions.precondition_offsets[op_index] + fact_index);
+}
+
+int BinaryRootTask::get_num_operator_effects(int op_index, bool is_axiom) const {
+    const Actions &actions = get_actions(is_axiom);
+    assert(op_index >= 0 && op_index < actions.costs.size);
+    return actions.effect_offsets[op_index + 1] - actions.effect_offsets[op_index];
+}
+
+int BinaryRootTask::get_num_operator_effect_conditions(
+    int op_index, int eff_index, bool is_axiom) const {
+    const Actions &actions = get_actions(is_axiom);
+    int index = get_effect_index(op_index, eff_index, is_axiom);
+    return actions.effect_condition_offsets[index + 1] -
+           actions.effect_condition_offsets[index];
+}
+
+FactPair BinaryRootTask::get_operator_effect_condition(
+    int op_index, int eff_index, int cond_index, bool is_axiom) const {
+    const Actions &actions = get_actions(is_axiom);
+    int index = get_effect_index(op_index, eff_index, is_axiom);
+    assert(cond_index >= 0 && cond_index <
+           get_num_operator_effect_conditions(op_index, eff_index, is_axiom));
+    return actions.effect_conditions.get_fact(
+        actions.effect_condition_offsets[index] + cond_index);
+}
+
+FactPair BinaryRootTask::get_operator_effect(
+    int op_index, int eff_index, bool is_axiom) const {
+    const Actions &actions = get_actions(is_axiom);
+    return actions.effects.get_fact(get_effect_index(op_index, eff_index, is_axiom));
+}
+
+int BinaryRootTask::convert_operator_index(
+    int index, const AbstractTask *ancestor_task) const {
+    if (this != ancestor_task) {
+        ABORT("Invalid operator ID conversion");
+    }
+    return index;
+}
+
+int BinaryRootTask::get_num_axioms() const {
+    return axioms.costs.size;
+}
+
+int BinaryRootTask::get_num_goals() const {
+    return goals.size / 2;
+}
+
+FactPair BinaryRootTask::get_goal_fact(int index) const {
+    assert(index >= 0 && index < get_num_goals());
+    return goals.get_fact(index);
+}
+
+vector<int> BinaryRootTask::get_initial_state_values() const {
+    return vector<int>(initial_state_values.data,
+                       initial_state_values.data + initial_state_values.size);
+}
+
+void BinaryRootTask::convert_state_values(
+    vector<int> &, const AbstractTask *ancestor_task) const {
+    if (this != ancestor_task) {
+        ABORT("Invalid state conversion");
+    }
+}
+}
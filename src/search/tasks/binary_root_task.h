@@ -0,0 +1,159 @@
+#ifndef TASKS_BINARY_ROOT_TASK_H
+#define TASKS_BINARY_ROOT_TASK_H
+
+#include "../abstract_task.h"
+
+#include <iosfwd>
+#include <memory>
+#include <vector>
+
+namespace utils {
+class MappedFile;
+}
+
+/*
+  Compact binary representation of root tasks.
+
+  Parsing the textual translator output and rebuilding the mutex sets
+  can take seconds for large tasks. The binary format stores the task as
+  a sequence of int arrays in the layout used by BinaryRootTask (e.g.,
+  operators are stored as offset tables into flat arrays of facts, and
+  mutexes as sorted lists per fact), so loading it only requires
+  checking the sizes and the validity of the stored facts. When the task
+  is read from a regular file, the file is memory-mapped and the task
+  accesses the mapped data directly.
+
+  A binary task is written with the command-line option
+  --write-binary-task FILE and can be passed to the planner instead of
+  the translator output. The input format is detected automatically.
+
+  The format uses the byte order of the machine that wrote it and is not
+  meant to be exchanged between machines.
+*/
+
+namespace tasks {
+extern const char BINARY_TASK_MAGIC[8];
+
+extern bool has_binary_task_magic(const char *data, size_t size);
+
+/*
+  Write the given task in the binary format. AbstractTask only allows
+  testing pairs of facts for mutual exclusion, so the caller passes the
+  facts that are mutex with each fact, indexed by the variables and
+  values of the facts.
+*/
+extern void write_binary_task(
+    const AbstractTask &task,
+    const std::vector<std::vector<std::vector<FactPair>>> &mutexes,
+    std::ostream &out);
+
+class BinaryRootTask : public AbstractTask {
+    struct Array {
+        const int *data;
+        int size;
+
+        Array() : data(nullptr), size(0) {}
+
+        int operator[](int index) const {
+            return data[index];
+        }
+
+        FactPair get_fact(int index) const {
+            return FactPair(data[2 * index], data[2 * index + 1]);
+        }
+    };
+
+    struct Actions {
+        Array costs;
+        Array precondition_offsets;
+        Array preconditions;
+        Array effect_offsets;
+        Array effects;
+        Array effect_condition_offsets;
+        Array effect_conditions;
+    };
+
+    std::unique_ptr<utils::MappedFile> file;
+    std::vector<char> buffer;
+    const char *data;
+    size_t size;
+
+    Array domain_sizes;
+    Array axiom_layers;
+    Array axiom_default_values;
+    Array initial_state_values;
+    Array variable_name_offsets;
+    Array variable_names;
+    Array fact_name_offsets;
+    Array fact_names;
+    Array mutex_offsets;
+    Array mutexes;
+    Array goals;
+    Actions operators;
+    Array operator_name_offsets;
+    Array operator_names;
+    Actions axioms;
+
+    // Index of the first fact of each variable in the per-fact arrays.
+    std::vector<int> fact_offsets;
+
+    void load();
+    const Actions &get_actions(bool is_axiom) const;
+    int get_effect_index(int op_index, int eff_index, bool is_axiom) const;
+
+public:
+    explicit BinaryRootTask(std::unique_ptr<utils::MappedFile> file);
+    explicit BinaryRootTask(std::vector<char> &&buffer);
+    virtual ~BinaryRootTask() override;
+
+    bool is_memory_mapped() const {
+        return file != nullptr;
+    }
+
+    size_t get_size_in_bytes() const {
+        return size;
+    }
+
+    void write(std::ostream &out) const;
+
+    virtual int get_num_variables() const override;
+    virtual std::string get_variable_name(int var) const override;
+    virtual int get_variable_domain_size(int var) const override;
+    virtual int get_variable_axiom_layer(int var) const override;
+    virtual int get_variable_default_axiom_value(int var) const override;
+    virtual std::string get_fact_name(const FactPair &fact) const override;
+    virtual bool are_facts_mutex(
+        const FactPair &fact1, const FactPair &fact2) const override;
+
+    virtual int get_operator_cost(int index, bool is_axiom) const override;
+    virtual std::string get_operator_name(
+        int index, bool is_axiom) const override;
+    virtual int get_num_operators() const override;
+    virtual int get_num_operator_preconditions(
+        int index, bool is_axiom) const override;
+    virtual FactPair get_operator_precondition(
+        int op_index, int fact_index, bool is_axiom) const override;
+    virtual int get_num_operator_effects(
+        int op_index, bool is_axiom) const override;
+    virtual int get_num_operator_effect_conditions(
+        int op_index, int eff_index, bool is_axiom) const override;
+    virtual FactPair get_operator_effect_condition(
+        int op_index, int eff_index, int cond_index, bool is_axiom) const override;
+    virtual FactPair get_operator_effect(
+        int op_index, int eff_index, bool is_axiom) const override;
+    virtual int convert_operator_index(
+        int index, const AbstractTask *ancestor_task) const override;
+
+    virtual int get_num_axioms() const override;
+
+    virtual int get_num_goals() const override;
+    virtual FactPair get_goal_fact(int index) const override;
+
+    virtual std::vector<int> get_initial_state_values() const override;
+    virtual void convert_state_values(
+        std::vector<int> &values,
+        const AbstractTask *ancestor_task) const override;
+};
+}
+
+#endif
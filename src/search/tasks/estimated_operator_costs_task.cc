@@ -0,0 +1,95 @@
+#include "estimated_operator_costs_task.h"
+
+#include "../option_parser.h"
+#include "../plugin.h"
+
+#include "../tasks/root_task.h"
+#include "../utils/logging.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+
+namespace extra_tasks {
+static shared_ptr<EstimatedOperatorCostsTask> estimated_operator_costs_task;
+
+static vector<int> get_operator_costs(const AbstractTask &task) {
+    int num_operators = task.get_num_operators();
+    vector<int> costs;
+    costs.reserve(num_operators);
+    for (int op_id = 0; op_id < num_operators; ++op_id)
+        costs.push_back(task.get_operator_cost(op_id, false));
+    return costs;
+}
+
+EstimatedOperatorCostsTask::EstimatedOperatorCostsTask(
+    const shared_ptr<AbstractTask> &parent)
+    : ModifiedOperatorCostsTask(parent, get_operator_costs(*parent)),
+      num_raised_costs(0) {
+}
+
+void EstimatedOperatorCostsTask::raise_operator_cost(int op_id, int cost) {
+    assert(op_id >= 0 && op_id < static_cast<int>(operator_costs.size()));
+    if (cost <= operator_costs[op_id])
+        return;
+    operator_costs[op_id] = cost;
+    ++num_raised_costs;
+    for (OperatorCostsListener *listener : listeners)
+        listener->notify_operator_cost_raised(op_id, cost);
+}
+
+void EstimatedOperatorCostsTask::subscribe(OperatorCostsListener *listener) {
+    assert(find(listeners.begin(), listeners.end(), listener) == listeners.end());
+    listeners.push_back(listener);
+}
+
+void EstimatedOperatorCostsTask::unsubscribe(OperatorCostsListener *listener) {
+    auto it = find(listeners.begin(), listeners.end(), listener);
+    assert(it != listeners.end());
+    listeners.erase(it);
+}
+
+void EstimatedOperatorCostsTask::print_statistics() const {
+    utils::g_log << "Raised estimated operator costs: "
+                 << num_raised_costs << endl;
+}
+
+shared_ptr<EstimatedOperatorCostsTask> get_estimated_operator_costs_task() {
+    if (!estimated_operator_costs_task) {
+        estimated_operator_costs_task =
+            make_shared<EstimatedOperatorCostsTask>(tasks::g_root_task);
+    }
+    return estimated_operator_costs_task;
+}
+
+void raise_estimated_operator_cost(int op_id, int cost) {
+    if (estimated_operator_costs_task)
+        estimated_operator_costs_task->raise_operator_cost(op_id, cost);
+}
+
+void print_estimated_operator_costs_statistics() {
+    if (estimated_operator_costs_task)
+        estimated_operator_costs_task->print_statistics();
+}
+
+
+static shared_ptr<AbstractTask> _parse(OptionParser &parser) {
+    parser.document_synopsis(
+        "Estimated-costs task",
+        "A transformation of the root task whose operator costs are the "
+        "best lower bounds on the true operator costs learned by the "
+        "edge-cost estimation searches so far. Heuristics using this "
+        "transformation become more informed as the search estimates "
+        "more edges. Heuristics that support updating their costs "
+        "incrementally (hmax, hadd, hff, lmcut and pdb) react to raised "
+        "costs, all others only see the costs at construction time.");
+    parser.parse();
+    if (parser.dry_run())
+        return nullptr;
+    else
+        return get_estimated_operator_costs_task();
+}
+
+static Plugin<AbstractTask> _plugin("estimated_costs", _parse);
+}
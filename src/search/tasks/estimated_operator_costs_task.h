@@ -0,0 +1,64 @@
+#ifndef TASKS_ESTIMATED_OPERATOR_COSTS_TASK_H
+#define TASKS_ESTIMATED_OPERATOR_COSTS_TASK_H
+
+#include "modified_operator_costs_task.h"
+
+#include <memory>
+#include <vector>
+
+/*
+  Task transformation whose operator costs are the best lower bounds on
+  the true operator costs that the edge-cost estimation searches (e.g.,
+  BEAUTY) have learned so far.
+
+  Initially, all operators have the costs of the root task. Whenever an
+  estimation yields a higher lower bound for an operator, the search
+  calls raise_estimated_operator_cost() and all heuristics computed on
+  this task are notified about the new cost. Costs never decrease, so
+  heuristic values computed with earlier costs stay admissible.
+
+  There is a single instance of the task, which is created the first
+  time the "estimated_costs" transformation is used, e.g., with
+  lmcut(transform=estimated_costs()). Searches do not learn costs if no
+  heuristic uses the task.
+*/
+
+namespace extra_tasks {
+class OperatorCostsListener {
+public:
+    virtual ~OperatorCostsListener() = default;
+    virtual void notify_operator_cost_raised(int op_id, int cost) = 0;
+};
+
+class EstimatedOperatorCostsTask : public ModifiedOperatorCostsTask {
+    std::vector<OperatorCostsListener *> listeners;
+    int num_raised_costs;
+
+public:
+    explicit EstimatedOperatorCostsTask(
+        const std::shared_ptr<AbstractTask> &parent);
+    virtual ~EstimatedOperatorCostsTask() override = default;
+
+    /*
+      Set the cost of the given operator to the given lower bound if it
+      is higher than the current cost and notify all listeners.
+    */
+    void raise_operator_cost(int op_id, int cost);
+
+    void subscribe(OperatorCostsListener *listener);
+    void unsubscribe(OperatorCostsListener *listener);
+
+    void print_statistics() const;
+};
+
+extern std::shared_ptr<EstimatedOperatorCostsTask> get_estimated_operator_costs_task();
+
+/*
+  Raise the cost of the given operator in the estimated-costs task. Does
+  nothing if no heuristic uses the task.
+*/
+extern void raise_estimated_operator_cost(int op_id, int cost);
+extern void print_estimated_operator_costs_statistics();
+}
+
+#endif
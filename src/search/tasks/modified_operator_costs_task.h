@@ -7,7 +7,8 @@
 
 namespace extra_tasks {
 class ModifiedOperatorCostsTask : public tasks::DelegatingTask {
-    const std::vector<int> operator_costs;
+protected:
+    std::vector<int> operator_costs;
 
 public:
     ModifiedOperatorCostsTask(
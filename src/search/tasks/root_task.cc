@@ -1,14 +1,21 @@
 #include "root_task.h"
 
+#include "binary_root_task.h"
+
 #include "../option_parser.h"
 #include "../plugin.h"
 #include "../state_registry.h"
 
 #include "../utils/collections.h"
+#include "../utils/logging.h"
+#include "../utils/mapped_file.h"
+#include "../utils/memory.h"
 #include "../utils/timer.h"
 
 #include <algorithm>
 #include <cassert>
+#include <fstream>
+#include <iterator>
 #include <memory>
 #include <set>
 #include <unordered_set>
@@ -69,6 +76,8 @@ class RootTask : public AbstractTask {
 public:
     explicit RootTask(istream &in);
 
+    void write_binary(ostream &out) const;
+
     virtual int get_num_variables() const override;
     virtual string get_variable_name(int var) const override;
     virtual int get_variable_domain_size(int var) const override;
@@ -359,6 +368,16 @@ RootTask::RootTask(istream &in) {
     axiom_evaluator.evaluate(initial_state_values);
 }
 
+void RootTask::write_binary(ostream &out) const {
+    vector<vector<vector<FactPair>>> mutex_lists(mutexes.size());
+    for (size_t var = 0; var < mutexes.size(); ++var) {
+        for (const set<FactPair> &fact_mutexes : mutexes[var]) {
+            mutex_lists[var].emplace_back(fact_mutexes.begin(), fact_mutexes.end());
+        }
+    }
+    write_binary_task(*this, mutex_lists, out);
+}
+
 const ExplicitVariable &RootTask::get_variable(int var) const {
     assert(utils::in_bounds(var, variables));
     return variables[var];
@@ -493,9 +512,59 @@ void RootTask::convert_state_values(
     }
 }
 
-void read_root_task(istream &in) {
+void read_root_task(istream &in, int fd) {
     assert(!g_root_task);
-    g_root_task = make_shared<RootTask>(in);
+    utils::Timer load_timer;
+    unique_ptr<utils::MappedFile> file;
+    if (fd != -1) {
+        file = utils::make_unique_ptr<utils::MappedFile>(fd);
+        if (!file->is_open() ||
+            !has_binary_task_magic(file->get_data(), file->get_size())) {
+            file = nullptr;
+        }
+    }
+    if (file) {
+        g_root_task = make_shared<BinaryRootTask>(move(file));
+    } else if (in.peek() == char_traits<char>::to_int_type(BINARY_TASK_MAGIC[0])) {
+        vector<char> buffer((istreambuf_iterator<char>(in)),
+                            istreambuf_iterator<char>());
+        g_root_task = make_shared<BinaryRootTask>(move(buffer));
+    } else {
+        g_root_task = make_shared<RootTask>(in);
+    }
+    load_timer.stop();
+
+    const BinaryRootTask *binary_task =
+        dynamic_cast<const BinaryRootTask *>(g_root_task.get());
+    if (binary_task) {
+        utils::g_log << "Task format: binary"
+                     << (binary_task->is_memory_mapped() ? " (memory-mapped)" : "")
+                     << endl;
+        utils::g_log << "Binary task size: "
+                     << binary_task->get_size_in_bytes() / 1024 << " KB" << endl;
+    } else {
+        utils::g_log << "Task format: text" << endl;
+    }
+    utils::g_log << "Time for loading task: " << load_timer << endl;
+}
+
+void write_binary_root_task(const string &file_name) {
+    assert(g_root_task);
+    utils::Timer write_timer;
+    ofstream out(file_name, ios::binary | ios::trunc);
+    const RootTask *text_task = dynamic_cast<const RootTask *>(g_root_task.get());
+    if (text_task) {
+        text_task->write_binary(out);
+    } else {
+        dynamic_cast<const BinaryRootTask &>(*g_root_task).write(out);
+    }
+    out.close();
+    if (out.fail()) {
+        cerr << "Could not write binary task to " << file_name << endl;
+        utils::exit_with(ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+    utils::g_log << "Wrote binary task to " << file_name
+                 << " [" << write_timer << "]" << endl;
 }
 
 static shared_ptr<AbstractTask> _parse(OptionParser &parser) {
@@ -5,6 +5,13 @@
 
 namespace tasks {
 extern std::shared_ptr<AbstractTask> g_root_task;
-extern void read_root_task(std::istream &in);
+/*
+  Read the root task in the textual translator output format or in the
+  binary format (see binary_root_task.h). If fd is the file descriptor
+  from which "in" reads and refers to a regular file in the binary
+  format, the file is memory-mapped instead of being read.
+*/
+extern void read_root_task(std::istream &in, int fd = -1);
+extern void write_binary_root_task(const std::string &file_name);
 }
 #endif
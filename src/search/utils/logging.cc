@@ -104,5 +104,21 @@ void trace(const string &msg) {
     _tracer.print_trace_message(msg);
 }
 
+thread_local ostream *Log::stream = &cout;
+thread_local bool Log::line_has_started = false;
+
 Log g_log;
+
+
+LogRedirection::LogRedirection(ostream &stream)
+    : previous_stream(Log::stream),
+      previous_line_has_started(Log::line_has_started) {
+    Log::stream = &stream;
+    Log::line_has_started = false;
+}
+
+LogRedirection::~LogRedirection() {
+    Log::stream = previous_stream;
+    Log::line_has_started = previous_line_has_started;
+}
 }
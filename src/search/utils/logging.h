@@ -19,21 +19,27 @@ namespace utils {
 
   Usage:
         utils::g_log << "States: " << num_states << endl;
+
+  Each thread writes its own lines and can temporarily redirect them to
+  another stream with a LogRedirection.
 */
 class Log {
 private:
-    bool line_has_started = false;
+    friend class LogRedirection;
+
+    static thread_local std::ostream *stream;
+    static thread_local bool line_has_started;
 
 public:
     template<typename T>
     Log &operator<<(const T &elem) {
         if (!line_has_started) {
             line_has_started = true;
-            std::cout << "[t=" << g_timer << ", "
-                      << get_peak_memory_in_kb() << " KB] ";
+            *stream << "[t=" << g_timer << ", "
+                    << get_peak_memory_in_kb() << " KB] ";
         }
 
-        std::cout << elem;
+        *stream << elem;
         return *this;
     }
 
@@ -43,13 +49,29 @@ public:
             line_has_started = false;
         }
 
-        std::cout << f;
+        *stream << f;
         return *this;
     }
 };
 
 extern Log g_log;
 
+/*
+  While this object exists, messages that the current thread writes to
+  g_log go to the given stream instead of stdout. Parallel jobs use this
+  to collect their output, which is then printed one job after the other.
+*/
+class LogRedirection {
+    std::ostream *previous_stream;
+    bool previous_line_has_started;
+public:
+    explicit LogRedirection(std::ostream &stream);
+    ~LogRedirection();
+
+    LogRedirection(const LogRedirection &) = delete;
+    LogRedirection &operator=(const LogRedirection &) = delete;
+};
+
 // See add_verbosity_option_to_parser for documentation.
 enum class Verbosity {
     SILENT,
@@ -0,0 +1,102 @@
+#include "mapped_file.h"
+
+#include "system.h"
+
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace utils {
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+static const char *map_file(int fd, off_t offset, size_t &size) {
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) == -1 || !S_ISREG(file_stat.st_mode) ||
+        file_stat.st_size <= offset) {
+        return nullptr;
+    }
+    /*
+      mmap requires page-aligned offsets, so we map from the start of the
+      page containing the offset and skip the prefix.
+    */
+    off_t page_size = sysconf(_SC_PAGESIZE);
+    off_t aligned_offset = offset / page_size * page_size;
+    size_t mapped_size = file_stat.st_size - aligned_offset;
+    void *address = mmap(nullptr, mapped_size, PROT_READ, MAP_PRIVATE,
+                         fd, aligned_offset);
+    if (address == MAP_FAILED) {
+        return nullptr;
+    }
+    size = file_stat.st_size - offset;
+    return static_cast<const char *>(address) + (offset - aligned_offset);
+}
+
+static void unmap_file(const char *data, size_t size) {
+    off_t page_size = sysconf(_SC_PAGESIZE);
+    size_t prefix = reinterpret_cast<uintptr_t>(data) % page_size;
+    munmap(const_cast<char *>(data - prefix), size + prefix);
+}
+
+MappedFile::MappedFile(const string &file_name)
+    : data(nullptr), size(0), is_mapped(false) {
+    int fd = open(file_name.c_str(), O_RDONLY);
+    if (fd != -1) {
+        data = map_file(fd, 0, size);
+        is_mapped = (data != nullptr);
+        close(fd);
+    }
+}
+
+MappedFile::MappedFile(int fd)
+    : data(nullptr), size(0), is_mapped(false) {
+    off_t offset = lseek(fd, 0, SEEK_CUR);
+    if (offset != -1) {
+        data = map_file(fd, offset, size);
+        is_mapped = (data != nullptr);
+    }
+}
+
+MappedFile::~MappedFile() {
+    if (is_mapped) {
+        unmap_file(data, size);
+    }
+}
+
+bool file_exists(const string &file_name) {
+    struct stat file_stat;
+    return stat(file_name.c_str(), &file_stat) == 0;
+}
+#else
+MappedFile::MappedFile(const string &file_name)
+    : data(nullptr), size(0), is_mapped(false) {
+    ifstream stream(file_name, ios::binary);
+    if (stream) {
+        buffer.assign(istreambuf_iterator<char>(stream),
+                      istreambuf_iterator<char>());
+        if (!stream.bad()) {
+            data = buffer.data();
+            size = buffer.size();
+        }
+    }
+}
+
+MappedFile::MappedFile(int)
+    : data(nullptr), size(0), is_mapped(false) {
+}
+
+MappedFile::~MappedFile() {
+}
+
+bool file_exists(const string &file_name) {
+    return static_cast<bool>(ifstream(file_name));
+}
+#endif
+}
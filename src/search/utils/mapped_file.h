@@ -0,0 +1,53 @@
+#ifndef UTILS_MAPPED_FILE_H
+#define UTILS_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace utils {
+/*
+  Read-only view of the contents of a file. On Unix systems, the file is
+  memory-mapped, so opening it is cheap and pages are only read from disk
+  when they are accessed. On other systems, the contents are read into
+  memory.
+*/
+class MappedFile {
+    const char *data;
+    size_t size;
+    std::vector<char> buffer;
+    bool is_mapped;
+
+public:
+    /*
+      Open the file with the given name. If the file cannot be opened or
+      read, is_open() returns false.
+    */
+    explicit MappedFile(const std::string &file_name);
+    /*
+      Map the file that is open under the given file descriptor, starting
+      at the current offset. The descriptor is not closed.
+    */
+    explicit MappedFile(int fd);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    bool is_open() const {
+        return data != nullptr;
+    }
+
+    const char *get_data() const {
+        return data;
+    }
+
+    size_t get_size() const {
+        return size;
+    }
+};
+
+extern bool file_exists(const std::string &file_name);
+}
+
+#endif
@@ -4,6 +4,7 @@
 
 #include <cassert>
 #include <iostream>
+#include <mutex>
 
 using namespace std;
 
@@ -14,8 +15,16 @@ static char *extra_memory_padding = nullptr;
 static void (*standard_out_of_memory_handler)() = nullptr;
 
 void continuing_out_of_memory_handler() {
-    release_extra_memory_padding();
-    utils::g_log << "Failed to allocate memory. Released extra memory padding." << endl;
+    /*
+      Parallel jobs may run out of memory at the same time. The first one
+      releases the padding, the others retry with the standard handler.
+    */
+    static mutex handler_mutex;
+    lock_guard<mutex> lock(handler_mutex);
+    if (extra_memory_padding) {
+        release_extra_memory_padding();
+        utils::g_log << "Failed to allocate memory. Released extra memory padding." << endl;
+    }
 }
 
 void reserve_extra_memory_padding(int memory_in_mb) {
@@ -0,0 +1,135 @@
+#include "thread_pool.h"
+
+#include "memory.h"
+
+#include <cassert>
+#include <cstdint>
+
+using namespace std;
+
+namespace utils {
+static unique_ptr<ThreadPool> thread_pool;
+// Set while the thread executes a job, so that nested calls run sequentially.
+static thread_local bool is_executing_job = false;
+
+ThreadPool::ThreadPool(int num_threads)
+    : current_job(nullptr),
+      current_num_jobs(0),
+      next_job(0),
+      num_unfinished_jobs(0),
+      batch(0),
+      shutting_down(false) {
+    assert(num_threads >= 1);
+    for (int worker = 1; worker < num_threads; ++worker)
+        workers.emplace_back(&ThreadPool::work, this, worker);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<std::mutex> lock(mutex);
+        shutting_down = true;
+    }
+    work_available.notify_all();
+    for (thread &worker : workers)
+        worker.join();
+}
+
+void ThreadPool::work(int worker) {
+    int last_batch = 0;
+    unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        work_available.wait(lock, [&]() {
+                                return shutting_down || batch != last_batch;
+                            });
+        if (shutting_down)
+            return;
+        last_batch = batch;
+        process_jobs(worker, lock);
+    }
+}
+
+void ThreadPool::process_jobs(int worker, unique_lock<std::mutex> &lock) {
+    while (next_job < current_num_jobs) {
+        int index = next_job++;
+        lock.unlock();
+        is_executing_job = true;
+        (*current_job)(index, worker);
+        is_executing_job = false;
+        lock.lock();
+        if (--num_unfinished_jobs == 0)
+            work_finished.notify_all();
+    }
+}
+
+void ThreadPool::run(int num_jobs, const function<void(int, int)> &job) {
+    if (num_jobs == 0)
+        return;
+    unique_lock<std::mutex> lock(mutex);
+    assert(!current_job);
+    current_job = &job;
+    current_num_jobs = num_jobs;
+    next_job = 0;
+    num_unfinished_jobs = num_jobs;
+    ++batch;
+    work_available.notify_all();
+    process_jobs(0, lock);
+    work_finished.wait(lock, [&]() {return num_unfinished_jobs == 0;});
+    current_job = nullptr;
+}
+
+void set_num_threads(int num_threads) {
+    if (num_threads > 1)
+        thread_pool = make_unique_ptr<ThreadPool>(num_threads);
+    else
+        thread_pool = nullptr;
+}
+
+ThreadPool *get_thread_pool() {
+    return thread_pool.get();
+}
+
+int get_available_num_threads() {
+    if (!thread_pool || is_executing_job)
+        return 1;
+    return thread_pool->get_num_threads();
+}
+
+void run_in_parallel(int num_jobs, const function<void(int, int)> &job) {
+    if (get_available_num_threads() > 1) {
+        thread_pool->run(num_jobs, job);
+    } else {
+        for (int index = 0; index < num_jobs; ++index)
+            job(index, 0);
+    }
+}
+
+void run_with_size_budget(
+    const vector<int> &sizes, int max_parallel_size,
+    const function<void(int, int)> &job) {
+    int num_jobs = sizes.size();
+    if (get_available_num_threads() == 1) {
+        run_in_parallel(num_jobs, job);
+        return;
+    }
+    std::mutex budget_mutex;
+    condition_variable budget_released;
+    int64_t used_size = 0;
+    thread_pool->run(num_jobs, [&](int index, int worker) {
+                         int64_t size = sizes[index];
+                         {
+                             unique_lock<std::mutex> lock(budget_mutex);
+                             budget_released.wait(lock, [&]() {
+                                                      return used_size == 0 ||
+                                                      used_size + size <= max_parallel_size;
+                                                  });
+                             used_size += size;
+                         }
+                         job(index, worker);
+                         {
+                             lock_guard<std::mutex> lock(budget_mutex);
+                             used_size -= size;
+                         }
+                         budget_released.notify_all();
+                     });
+}
+}
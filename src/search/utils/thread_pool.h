@@ -0,0 +1,86 @@
+#ifndef UTILS_THREAD_POOL_H
+#define UTILS_THREAD_POOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace utils {
+/*
+  A fixed set of worker threads that process batches of independent jobs.
+
+  run(num_jobs, job) calls job(index, worker) for all indices in
+  [0, num_jobs) and returns once all calls have finished. The calling
+  thread takes part in the work as worker 0, the other threads have the
+  IDs 1, ..., get_num_threads() - 1. Jobs are handed out in the order of
+  their indices, but may finish in any order. Jobs can use the worker ID
+  to access per-thread scratch data and must not call run() themselves.
+  Nested calls of run_in_parallel() and run_with_size_budget() from within
+  a job are fine: they process their jobs sequentially.
+
+  The planner uses a single global pool, which is configured with the
+  command-line option --threads.
+*/
+class ThreadPool {
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable work_available;
+    std::condition_variable work_finished;
+
+    const std::function<void(int, int)> *current_job;
+    int current_num_jobs;
+    int next_job;
+    int num_unfinished_jobs;
+    int batch;
+    bool shutting_down;
+
+    void work(int worker);
+    void process_jobs(int worker, std::unique_lock<std::mutex> &lock);
+public:
+    explicit ThreadPool(int num_threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    int get_num_threads() const {
+        return workers.size() + 1;
+    }
+
+    void run(int num_jobs, const std::function<void(int, int)> &job);
+};
+
+extern void set_num_threads(int num_threads);
+// Return nullptr if the planner runs single-threaded.
+extern ThreadPool *get_thread_pool();
+
+/*
+  Return the number of threads that run_in_parallel() uses when it is
+  called from the current thread. This is 1 if the planner runs
+  single-threaded or if the current thread executes a job of the pool.
+*/
+extern int get_available_num_threads();
+
+/*
+  Call job(index, worker) for all indices in [0, num_jobs) on the global
+  thread pool, or one after the other if get_available_num_threads() is 1.
+*/
+extern void run_in_parallel(
+    int num_jobs, const std::function<void(int, int)> &job);
+
+/*
+  Call job(index, worker) for all indices in [0, sizes.size()), using the
+  global thread pool if there is one. A job only starts while the sizes of
+  all running jobs plus its own size are at most max_parallel_size, except
+  that a job may always run on its own. Callers use the sizes to bound the
+  memory of jobs that build large data structures concurrently.
+*/
+extern void run_with_size_budget(
+    const std::vector<int> &sizes, int max_parallel_size,
+    const std::function<void(int, int)> &job);
+}
+
+#endif